@@ -0,0 +1,75 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+namespace evmmax
+{
+/// The x86-64 CPU features used to select the implementations at runtime.
+///
+/// The vector extensions are reported only if the OS also preserves their registers.
+struct CpuFeatures
+{
+    bool sse41 = false;
+    bool bmi1 = false;
+    bool bmi2 = false;
+    bool adx = false;
+    bool sha = false;
+    bool avx2 = false;
+    bool avx512ifma = false;  ///< AVX-512F and AVX-512 IFMA.
+};
+
+/// Detects the features of the CPU with the CPUID instruction.
+inline CpuFeatures detect_cpu_features() noexcept
+{
+    CpuFeatures f;
+#if defined(__x86_64__)
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+    if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) == 0 || eax < 1)
+        return f;
+    const auto max_leaf = eax;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    f.sse41 = (ecx & (1 << 19)) != 0;
+    const bool os_xsave = (ecx & (1 << 27)) != 0;
+    const bool hw_avx = (ecx & (1 << 28)) != 0;
+
+    // The OS must preserve the XMM and YMM registers (XCR0 bits 1 and 2) for AVX
+    // and additionally the opmask and ZMM registers (XCR0 bits 5-7) for AVX-512.
+    unsigned xcr0 = 0;
+    if (os_xsave)
+    {
+        unsigned xcr0_hi = 0;
+        __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0_hi) : "c"(0));
+    }
+    const bool os_avx = hw_avx && (xcr0 & 0x6) == 0x6;
+    const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+
+    if (max_leaf < 7)
+        return f;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    f.bmi1 = (ebx & (1 << 3)) != 0;
+    f.avx2 = os_avx && (ebx & (1 << 5)) != 0;
+    f.bmi2 = (ebx & (1 << 8)) != 0;
+    f.adx = (ebx & (1 << 19)) != 0;
+    f.sha = (ebx & (1 << 29)) != 0;
+    f.avx512ifma = os_avx512 && (ebx & (1 << 16)) != 0 && (ebx & (1 << 21)) != 0;
+#endif
+    return f;
+}
+
+/// Returns the features of the CPU, detected once.
+inline const CpuFeatures& cpu_features() noexcept
+{
+    static const auto features = detect_cpu_features();
+    return features;
+}
+}  // namespace evmmax
@@ -4,9 +4,233 @@
 #pragma once
 
 #include <intx/intx.hpp>
+#include <array>
+#include <cassert>
+#include <span>
+#include <string_view>
 
 namespace evmmax
 {
+namespace detail
+{
+/// The modular inversion with the safegcd algorithm.
+///
+/// Daniel J. Bernstein and Bo-Yin Yang
+/// "Fast constant-time gcd computation and modular inversion"
+/// https://gcd.cr.yp.to/safegcd-20190413.pdf
+///
+/// This follows the constant-time implementation of libsecp256k1 (the "half-delta" divsteps
+/// processed in batches of 59 and the numbers represented by signed 62-bit limbs):
+/// https://github.com/bitcoin-core/secp256k1/blob/master/doc/safegcd_implementation.md
+namespace safegcd
+{
+/// The 256-bit number represented by 5 signed 62-bit limbs (the least significant first).
+using Signed62 = std::array<int64_t, 5>;
+
+/// The 2x2 transition matrix of the batch of 59 divsteps, scaled by 2^62.
+struct Trans2x2
+{
+    int64_t u;
+    int64_t v;
+    int64_t q;
+    int64_t r;
+};
+
+constexpr uint64_t M62 = ~uint64_t{0} >> 2;
+
+/// Signed 64x64 multiplication. The 128-bit result is in two's complement.
+constexpr intx::uint128 smul(int64_t a, int64_t b) noexcept
+{
+    auto p = intx::umul(static_cast<uint64_t>(a), static_cast<uint64_t>(b));
+    p[1] -= static_cast<uint64_t>(b) & static_cast<uint64_t>(a >> 63);
+    p[1] -= static_cast<uint64_t>(a) & static_cast<uint64_t>(b >> 63);
+    return p;
+}
+
+/// Arithmetic right shift by 62 of the signed 128-bit number.
+constexpr intx::uint128 sar62(const intx::uint128& x) noexcept
+{
+    intx::uint128 r;
+    r[0] = (x[0] >> 62) | (x[1] << 2);
+    r[1] = static_cast<uint64_t>(static_cast<int64_t>(x[1]) >> 62);
+    return r;
+}
+
+constexpr Signed62 to_signed62(const intx::uint256& x) noexcept
+{
+    return {static_cast<int64_t>(x[0] & M62),
+        static_cast<int64_t>(((x[0] >> 62) | (x[1] << 2)) & M62),
+        static_cast<int64_t>(((x[1] >> 60) | (x[2] << 4)) & M62),
+        static_cast<int64_t>(((x[2] >> 58) | (x[3] << 6)) & M62), static_cast<int64_t>(x[3] >> 56)};
+}
+
+/// Converts the normalized number (all limbs non-negative) back to uint256.
+constexpr intx::uint256 from_signed62(const Signed62& a) noexcept
+{
+    const auto a0 = static_cast<uint64_t>(a[0]);
+    const auto a1 = static_cast<uint64_t>(a[1]);
+    const auto a2 = static_cast<uint64_t>(a[2]);
+    const auto a3 = static_cast<uint64_t>(a[3]);
+    const auto a4 = static_cast<uint64_t>(a[4]);
+    return {
+        a0 | (a1 << 62), (a1 >> 2) | (a2 << 60), (a2 >> 4) | (a3 << 58), (a3 >> 6) | (a4 << 56)};
+}
+
+/// Performs 59 divsteps on the low bits of f and g and computes the transition matrix.
+/// The zeta is -(delta + 1/2). Returns the updated zeta.
+constexpr int64_t divsteps_59(int64_t zeta, uint64_t f, uint64_t g, Trans2x2& t) noexcept
+{
+    // Start with the identity matrix scaled by 2^3 to get it scaled by 2^62 after 59 steps.
+    uint64_t u = 8;
+    uint64_t v = 0;
+    uint64_t q = 0;
+    uint64_t r = 8;
+
+    for (int i = 3; i < 62; ++i)
+    {
+        // Branchless version of:
+        // if (zeta < 0 && g is odd): (zeta, f, g) = (-zeta - 1, g, (g - f) / 2)
+        // elif (g is odd):           (zeta, f, g) = (zeta - 1, f, (g + f) / 2)
+        // else:                      (zeta, f, g) = (zeta - 1, f, g / 2)
+        auto mask1 = static_cast<uint64_t>(zeta >> 63);  // zeta < 0
+        const auto mask2 = 0 - (g & 1);                   // g is odd
+        const auto x = (f ^ mask1) - mask1;
+        const auto y = (u ^ mask1) - mask1;
+        const auto z = (v ^ mask1) - mask1;
+        g += x & mask2;
+        q += y & mask2;
+        r += z & mask2;
+        mask1 &= mask2;
+        zeta = (zeta ^ static_cast<int64_t>(mask1)) - 1;
+        f += g & mask1;
+        u += q & mask1;
+        v += r & mask1;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+
+    t = {static_cast<int64_t>(u), static_cast<int64_t>(v), static_cast<int64_t>(q),
+        static_cast<int64_t>(r)};
+    return zeta;
+}
+
+/// Computes (t / 2^62) * [d, e] mod m, keeping the results in range (-2m, m).
+constexpr void update_de(Signed62& d, Signed62& e, const Trans2x2& t, const Signed62& m,
+    uint64_t m_inv62) noexcept
+{
+    const auto [u, v, q, r] = t;
+
+    // Add the multiples of m [md, me] to make the results in range
+    // and their low 62 bits zero so that they can be divided by 2^62.
+    const auto sd = d[4] >> 63;
+    const auto se = e[4] >> 63;
+    auto md = (u & sd) + (v & se);
+    auto me = (q & sd) + (r & se);
+    auto cd = smul(u, d[0]) + smul(v, e[0]);
+    auto ce = smul(q, d[0]) + smul(r, e[0]);
+    md -= static_cast<int64_t>((m_inv62 * cd[0] + static_cast<uint64_t>(md)) & M62);
+    me -= static_cast<int64_t>((m_inv62 * ce[0] + static_cast<uint64_t>(me)) & M62);
+    cd += smul(m[0], md);
+    ce += smul(m[0], me);
+    assert((cd[0] & M62) == 0 && (ce[0] & M62) == 0);
+    cd = sar62(cd);
+    ce = sar62(ce);
+
+    for (size_t i = 1; i < d.size(); ++i)
+    {
+        cd += smul(u, d[i]) + smul(v, e[i]) + smul(m[i], md);
+        ce += smul(q, d[i]) + smul(r, e[i]) + smul(m[i], me);
+        d[i - 1] = static_cast<int64_t>(cd[0] & M62);
+        e[i - 1] = static_cast<int64_t>(ce[0] & M62);
+        cd = sar62(cd);
+        ce = sar62(ce);
+    }
+    d[4] = static_cast<int64_t>(cd[0]);
+    e[4] = static_cast<int64_t>(ce[0]);
+}
+
+/// Computes (t / 2^62) * [f, g].
+constexpr void update_fg(Signed62& f, Signed62& g, const Trans2x2& t) noexcept
+{
+    const auto [u, v, q, r] = t;
+
+    auto cf = smul(u, f[0]) + smul(v, g[0]);
+    auto cg = smul(q, f[0]) + smul(r, g[0]);
+    assert((cf[0] & M62) == 0 && (cg[0] & M62) == 0);
+    cf = sar62(cf);
+    cg = sar62(cg);
+
+    for (size_t i = 1; i < f.size(); ++i)
+    {
+        cf += smul(u, f[i]) + smul(v, g[i]);
+        cg += smul(q, f[i]) + smul(r, g[i]);
+        f[i - 1] = static_cast<int64_t>(cf[0] & M62);
+        g[i - 1] = static_cast<int64_t>(cg[0] & M62);
+        cf = sar62(cf);
+        cg = sar62(cg);
+    }
+    f[4] = static_cast<int64_t>(cf[0]);
+    g[4] = static_cast<int64_t>(cg[0]);
+}
+
+/// Brings the value r in range (-2m, m) to [0, m), negating it if the sign is negative.
+constexpr void normalize(Signed62& r, int64_t sign, const Signed62& m) noexcept
+{
+    constexpr auto propagate_carries = [](Signed62& a) noexcept {
+        for (size_t i = 0; i < a.size() - 1; ++i)
+        {
+            a[i + 1] += a[i] >> 62;
+            a[i] &= static_cast<int64_t>(M62);
+        }
+    };
+
+    // Add the modulus if r is negative, then negate if requested.
+    const auto cond_add1 = r[4] >> 63;
+    for (size_t i = 0; i < r.size(); ++i)
+        r[i] += m[i] & cond_add1;
+    const auto cond_negate = sign >> 63;
+    for (auto& limb : r)
+        limb = (limb ^ cond_negate) - cond_negate;
+    propagate_carries(r);
+
+    // Add the modulus again if the result is still negative.
+    const auto cond_add2 = r[4] >> 63;
+    for (size_t i = 0; i < r.size(); ++i)
+        r[i] += m[i] & cond_add2;
+    propagate_carries(r);
+}
+
+/// Computes the modular inverse x⁻¹ mod m for the odd modulus m.
+/// The m_inv is the inverse of the modulus mod 2^64. The inverse of 0 is 0.
+constexpr intx::uint256 inv(
+    const intx::uint256& x, const intx::uint256& mod, uint64_t mod_inv) noexcept
+{
+    const auto m = to_signed62(mod);
+    Signed62 d{};
+    Signed62 e{1};
+    auto f = m;
+    auto g = to_signed62(x);
+    int64_t zeta = -1;  // zeta = -(delta + 1/2), delta starts at 1/2.
+
+    // 10 batches of 59 divsteps are enough for any 256-bit inputs.
+    for (int i = 0; i < 10; ++i)
+    {
+        Trans2x2 t{};
+        zeta = divsteps_59(zeta, static_cast<uint64_t>(f[0]), static_cast<uint64_t>(g[0]), t);
+        update_de(d, e, t, m, mod_inv);
+        update_fg(f, g, t);
+    }
+
+    // Now g = 0 and f = ±gcd(x, m) = ±1. The d = ±x⁻¹.
+    normalize(d, f[4], m);
+    return from_signed62(d);
+}
+}  // namespace safegcd
+}  // namespace detail
+
+template <typename UintT>
+class SparseModArith;
 
 /// The modular arithmetic operations for EVMMAX (EVM Modular Arithmetic Extensions).
 template <typename UintT>
@@ -53,6 +277,8 @@ private:
         return {p[1], p[0]};
     }
 
+    friend class SparseModArith<UintT>;
+
 public:
     constexpr explicit ModArith(const UintT& modulus) noexcept
       : mod{modulus},
@@ -72,11 +298,15 @@ public:
     /// Montgomery multiplication mul(x, 1) what gives aRR⁻¹ % mod = a % mod.
     constexpr UintT from_mont(const UintT& x) const noexcept { return mul(x, 1); }
 
+    /// Checks if the arithmetic is specialized for the sparse modulus (see SparseModArith).
+    static constexpr bool is_sparse() noexcept { return false; }
+
     /// Performs a Montgomery modular multiplication.
     ///
     /// Inputs must be in Montgomery form: x = aR, y = bR.
     /// This computes Montgomery multiplication xyR⁻¹ % mod what gives aRbRR⁻¹ % mod = abR % mod.
     /// The result (abR) is in Montgomery form.
+    /// The product x⋅y must be less than mod⋅R, e.g. x < R and y < mod as in to_mont().
     constexpr UintT mul(const UintT& x, const UintT& y) const noexcept
     {
         // Coarsely Integrated Operand Scanning (CIOS) Method
@@ -94,7 +324,7 @@ public:
                 std::tie(c, t[j]) = addmul(t[j], x[j], y[i], c);
             auto tmp = intx::addc(t[S], c);
             t[S] = tmp.value;
-            const auto d = tmp.carry;  // TODO: Carry is 0 for sparse modulus.
+            const auto d = tmp.carry;
 
             const auto m = t[0] * m_mod_inv;
             std::tie(c, std::ignore) = addmul(t[0], m, mod[0], 0);
@@ -102,7 +332,7 @@ public:
                 std::tie(c, t[j - 1]) = addmul(t[j], m, mod[j], c);
             tmp = intx::addc(t[S], c);
             t[S - 1] = tmp.value;
-            t[S] = d + tmp.carry;  // TODO: Carry is 0 for sparse modulus.
+            t[S] = d + tmp.carry;
         }
 
         if (t >= mod)
@@ -111,11 +341,33 @@ public:
         return static_cast<UintT>(t);
     }
 
+    /// Performs the Montgomery multiplications of multiple pairs: r[i] = mul(x[i], y[i]).
+    ///
+    /// The implementation is selected at runtime for the CPU (see mul_batch_implementation()).
+    /// On x86-64 this uses MULX/ADX instructions and processes 8 multiplications at once
+    /// with AVX-512 IFMA. Available for 256-bit and 384-bit moduli.
+    /// The spans must have the same size. The output may be the same as one of the inputs.
+    void mul_batch(
+        std::span<UintT> r, std::span<const UintT> x, std::span<const UintT> y) const noexcept;
+
+    /// Computes the modular inverse using the safegcd algorithm.
+    ///
+    /// The input and the result are in Montgomery form: for x = aR it returns a⁻¹R.
+    /// The inverse of 0 is 0.
+    constexpr UintT inv(const UintT& x) const noexcept
+        requires(UintT::num_bits == 256)
+    {
+        // The plain inverse of aR is a⁻¹R⁻¹. Multiply it twice by R² to get a⁻¹R.
+        // The m_mod_inv is -mod⁻¹ mod 2⁶⁴.
+        const auto y = detail::safegcd::inv(x, mod, 0 - m_mod_inv);
+        return mul(mul(y, m_r_squared), m_r_squared);
+    }
+
     /// Performs a modular addition. It is required that x < mod and y < mod, but x and y may be
     /// but are not required to be in Montgomery form.
     constexpr UintT add(const UintT& x, const UintT& y) const noexcept
     {
-        const auto s = addc(x, y);  // TODO: cannot overflow if modulus is sparse (e.g. 255 bits).
+        const auto s = addc(x, y);
         const auto d = subc(s.value, mod);
         return (!s.carry && d.carry) ? s.value : d.value;
     }
@@ -129,4 +381,80 @@ public:
         return (d.carry) ? s : d.value;
     }
 };
+
+/// The modular arithmetic for the sparse modulus: its two most significant bits are 0,
+/// i.e. 4⋅mod < R (e.g. the BN254 field prime).
+///
+/// For the sparse modulus the carries in add() and mul() are always 0 and the cheaper
+/// variants of these are used. Moreover, mul() accepts not fully reduced inputs
+/// x, y < 2⋅mod (lazy reduction), e.g. sums of two values without the final subtraction.
+/// The conversions to_mont() and from_mont() of the ModArith accept any inputs.
+template <typename UintT>
+class SparseModArith : public ModArith<UintT>
+{
+public:
+    constexpr explicit SparseModArith(const UintT& modulus) noexcept : ModArith<UintT>{modulus}
+    {
+        assert((modulus[UintT::num_words - 1] >> 62) == 0);
+    }
+
+    static constexpr bool is_sparse() noexcept { return true; }
+
+    /// Performs a Montgomery modular multiplication (see ModArith::mul()).
+    ///
+    /// This is the CIOS method without the carry handling. The intermediate value
+    /// t < x + mod < R fits in S words so the extra word of t is not needed: the final carries
+    /// of the multiplication and the reduction rows are added together to the top word.
+    /// See "Faster Montgomery multiplication" https://hackmd.io/@gnark/modular_multiplication.
+    /// The inputs must be less than 2⋅mod.
+    constexpr UintT mul(const UintT& x, const UintT& y) const noexcept
+    {
+        constexpr auto S = UintT::num_words;  // TODO(C++23): Make it static
+
+        UintT t;
+        for (size_t i = 0; i != S; ++i)
+        {
+            uint64_t a = 0;
+            std::tie(a, t[0]) = ModArith<UintT>::addmul(t[0], x[0], y[i], 0);
+            const auto m = t[0] * this->m_mod_inv;
+            uint64_t c = 0;
+            std::tie(c, std::ignore) = ModArith<UintT>::addmul(t[0], m, this->mod[0], 0);
+            for (size_t j = 1; j != S; ++j)
+            {
+                std::tie(a, t[j]) = ModArith<UintT>::addmul(t[j], x[j], y[i], a);
+                std::tie(c, t[j - 1]) = ModArith<UintT>::addmul(t[j], m, this->mod[j], c);
+            }
+            t[S - 1] = c + a;
+        }
+
+        if (t >= this->mod)
+            t -= this->mod;
+
+        return t;
+    }
+
+    /// Performs a modular addition (see ModArith::add()). The sum cannot overflow.
+    constexpr UintT add(const UintT& x, const UintT& y) const noexcept
+    {
+        const auto s = x + y;
+        const auto d = subc(s, this->mod);
+        return d.carry ? s : d.value;
+    }
+};
+
+template <>
+void ModArith<intx::uint256>::mul_batch(std::span<intx::uint256> r,
+    std::span<const intx::uint256> x, std::span<const intx::uint256> y) const noexcept;
+
+template <>
+void ModArith<intx::uint384>::mul_batch(std::span<intx::uint384> r,
+    std::span<const intx::uint384> x, std::span<const intx::uint384> y) const noexcept;
+
+/// Returns the name of the ModArith::mul_batch() implementation selected for the CPU:
+/// "avx512ifma", "adx" or "portable".
+const char* mul_batch_implementation() noexcept;
+
+/// Selects the ModArith::mul_batch() implementation by its name (for testing).
+/// Returns false and keeps the current one if the implementation is not supported by the CPU.
+bool set_mul_batch_implementation(std::string_view name) noexcept;
 }  // namespace evmmax
@@ -0,0 +1,404 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <evmmax/cpu_features.hpp>
+#include <evmmax/evmmax.hpp>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace evmmax
+{
+namespace
+{
+enum class MulBackend
+{
+    portable,
+    adx,
+    ifma,
+};
+
+/// The fastest implementation of ModArith::mul_batch() supported by the CPU.
+/// The implementations are ordered so all the preceding ones are also supported.
+MulBackend best_mul_backend = MulBackend::portable;
+
+/// The implementation of ModArith::mul_batch() in use.
+MulBackend mul_backend = MulBackend::portable;
+
+/// The names of the implementations, in the order of MulBackend.
+constexpr const char* MUL_BACKEND_NAMES[]{"portable", "adx", "avx512ifma"};
+
+template <typename UintT>
+void mul_batch_portable(const ModArith<UintT>& arith, UintT* r, const UintT* x, const UintT* y,
+    size_t n) noexcept
+{
+    for (size_t i = 0; i != n; ++i)
+        r[i] = arith.mul(x[i], y[i]);
+}
+
+#if defined(__x86_64__)
+
+/// The step of the ADX row:
+/// t[j] += lo(a[j]⋅b) in the CF chain, t[j+1] += hi(a[j]⋅b) in the OF chain.
+#define EVMMAX_ADX_STEP(j, tj, tj1)              \
+    "mulx " #j "*8(%[a]), %[lo], %[hi]\n\t"      \
+    "adcx %[lo], %[" #tj "]\n\t"                 \
+    "adox %[hi], %[" #tj1 "]\n\t"
+
+/// Adds the product a⋅b to t using the MULX and ADCX/ADOX instructions.
+///
+/// The low and high words of the partial products are accumulated in two independent
+/// carry chains (CF and OF) so the additions do not wait for each other.
+/// Compilers do not emit ADCX/ADOX for the _addcarryx_u64() intrinsic
+/// (the carry flag is serialized instead) so this is written in inline assembly.
+template <size_t S>
+__attribute__((target("adx,bmi2"))) inline void addmul_adx(
+    uint64_t (&t)[S + 2], const uint64_t (&a)[S], uint64_t b) noexcept
+{
+    uint64_t lo;
+    uint64_t hi;
+    if constexpr (S == 4)
+    {
+        __asm__(
+            "xorl %k[lo], %k[lo]\n\t"  // Clear CF and OF.
+            EVMMAX_ADX_STEP(0, t0, t1) EVMMAX_ADX_STEP(1, t1, t2) EVMMAX_ADX_STEP(2, t2, t3)
+                EVMMAX_ADX_STEP(3, t3, t4)
+            "movl $0, %k[lo]\n\t"
+            "adcx %[lo], %[t4]\n\t"
+            "adox %[lo], %[t5]\n\t"
+            "adcx %[lo], %[t5]"
+            : [t0] "+r"(t[0]), [t1] "+r"(t[1]), [t2] "+r"(t[2]), [t3] "+r"(t[3]),
+            [t4] "+r"(t[4]), [t5] "+r"(t[5]), [lo] "=&r"(lo), [hi] "=&r"(hi)
+            : [a] "r"(a), "m"(a), "d"(b)
+            : "cc");
+    }
+    else
+    {
+        static_assert(S == 6);
+        __asm__(
+            "xorl %k[lo], %k[lo]\n\t"  // Clear CF and OF.
+            EVMMAX_ADX_STEP(0, t0, t1) EVMMAX_ADX_STEP(1, t1, t2) EVMMAX_ADX_STEP(2, t2, t3)
+                EVMMAX_ADX_STEP(3, t3, t4) EVMMAX_ADX_STEP(4, t4, t5) EVMMAX_ADX_STEP(5, t5, t6)
+            "movl $0, %k[lo]\n\t"
+            "adcx %[lo], %[t6]\n\t"
+            "adox %[lo], %[t7]\n\t"
+            "adcx %[lo], %[t7]"
+            : [t0] "+r"(t[0]), [t1] "+r"(t[1]), [t2] "+r"(t[2]), [t3] "+r"(t[3]),
+            [t4] "+r"(t[4]), [t5] "+r"(t[5]), [t6] "+r"(t[6]), [t7] "+r"(t[7]), [lo] "=&r"(lo),
+            [hi] "=&r"(hi)
+            : [a] "r"(a), "m"(a), "d"(b)
+            : "cc");
+    }
+}
+#undef EVMMAX_ADX_STEP
+
+/// The CIOS Montgomery multiplication of S-word numbers (see ModArith::mul())
+/// using the MULX and ADCX/ADOX instructions.
+template <size_t S>
+__attribute__((target("adx,bmi2"))) inline void mont_mul_adx(uint64_t (&r)[S],
+    const uint64_t (&x)[S], const uint64_t (&y)[S], const uint64_t (&mod)[S],
+    uint64_t mod_inv) noexcept
+{
+    uint64_t t[S + 2]{};
+    for (size_t i = 0; i != S; ++i)
+    {
+        addmul_adx<S>(t, x, y[i]);
+        addmul_adx<S>(t, mod, t[0] * mod_inv);
+
+        // The lowest word is 0 now. Shift t down by one word.
+        for (size_t j = 0; j != S + 1; ++j)
+            t[j] = t[j + 1];
+        t[S + 1] = 0;
+    }
+
+    // The result t < 2mod. Subtract the modulus if t >= mod.
+    unsigned long long d[S];
+    unsigned char borrow = 0;
+    for (size_t j = 0; j != S; ++j)
+        borrow = _subborrow_u64(borrow, t[j], mod[j], &d[j]);
+    const bool lt = borrow != 0 && t[S] == 0;
+    for (size_t j = 0; j != S; ++j)
+        r[j] = lt ? t[j] : d[j];
+}
+
+template <typename UintT>
+__attribute__((target("adx,bmi2"))) void mul_batch_adx(const UintT& mod, uint64_t mod_inv,
+    UintT* r, const UintT* x, const UintT* y, size_t n) noexcept
+{
+    static constexpr auto S = UintT::num_words;
+    uint64_t m[S];
+    for (size_t j = 0; j != S; ++j)
+        m[j] = mod[j];
+
+    for (size_t i = 0; i != n; ++i)
+    {
+        uint64_t a[S];
+        uint64_t b[S];
+        for (size_t j = 0; j != S; ++j)
+        {
+            a[j] = x[i][j];
+            b[j] = y[i][j];
+        }
+        uint64_t c[S];
+        mont_mul_adx<S>(c, a, b, m, mod_inv);
+        for (size_t j = 0; j != S; ++j)
+            r[i][j] = c[j];
+    }
+}
+
+/// The AVX-512 IFMA representation of numbers: 52-bit limbs in 64-bit lanes.
+namespace ifma
+{
+constexpr uint64_t MASK52 = (uint64_t{1} << 52) - 1;
+
+/// The number of SIMD lanes: the number of multiplications done at once.
+constexpr size_t LANES = 8;
+
+/// The number of 52-bit limbs needed for S-word numbers with 2 spare bits
+/// (the intermediate results are below 4mod).
+template <size_t S>
+constexpr size_t NUM_LIMBS = (64 * S + 2 + 51) / 52;
+
+template <size_t S>
+void to_limbs(uint64_t* limbs, const uint64_t* words) noexcept
+{
+    for (size_t k = 0; k != NUM_LIMBS<S>; ++k)
+    {
+        const auto i = 52 * k / 64;
+        const auto s = 52 * k % 64;
+        auto v = words[i] >> s;
+        if (s > 12 && i + 1 < S)
+            v |= words[i + 1] << (64 - s);
+        limbs[k] = v & MASK52;
+    }
+}
+
+template <size_t S>
+void from_limbs(uint64_t* words, const uint64_t* limbs) noexcept
+{
+    for (size_t i = 0; i != S; ++i)
+        words[i] = 0;
+    for (size_t k = 0; k != NUM_LIMBS<S>; ++k)
+    {
+        const auto i = 52 * k / 64;
+        const auto s = 52 * k % 64;
+        words[i] |= limbs[k] << s;
+        if (s > 12 && i + 1 < S)
+            words[i + 1] |= limbs[k] >> (64 - s);
+    }
+}
+
+/// Multiplies LANES pairs of values in Montgomery form with AVX-512 IFMA.
+///
+/// The Montgomery reduction works with the 52-bit digits but the result must be
+/// abR⁻¹ with R = 2^(64S) as in ModArith::mul(). Therefore, the last reduction step only
+/// removes the remaining 64S - 52(L-1) bits.
+/// Returns the number of processed values: n rounded down to a multiple of LANES.
+template <typename UintT>
+__attribute__((target("avx512f,avx512ifma"))) size_t mul_batch(const UintT& mod,
+    uint64_t mod_inv, UintT* r, const UintT* x, const UintT* y, size_t n) noexcept
+{
+    static constexpr auto S = UintT::num_words;
+    static constexpr auto L = NUM_LIMBS<S>;
+    static constexpr auto LAST_BITS = static_cast<unsigned>(64 * S - 52 * (L - 1));
+    static_assert(LAST_BITS > 0 && LAST_BITS <= 52);
+
+    uint64_t mod_words[S];
+    for (size_t j = 0; j != S; ++j)
+        mod_words[j] = mod[j];
+    uint64_t mod_limbs[L];
+    to_limbs<S>(mod_limbs, mod_words);
+
+    __m512i m[L];
+    for (size_t j = 0; j != L; ++j)
+        m[j] = _mm512_set1_epi64(static_cast<long long>(mod_limbs[j]));
+    const auto minv = _mm512_set1_epi64(static_cast<long long>(mod_inv & MASK52));
+    const auto mask52 = _mm512_set1_epi64(static_cast<long long>(MASK52));
+    const auto mask_last =
+        _mm512_set1_epi64(static_cast<long long>((uint64_t{1} << LAST_BITS) - 1));
+    const auto zero = _mm512_setzero_si512();
+
+    size_t done = 0;
+    for (; done + LANES <= n; done += LANES)
+    {
+        alignas(64) uint64_t a[L][LANES];
+        alignas(64) uint64_t b[L][LANES];
+        for (size_t lane = 0; lane != LANES; ++lane)
+        {
+            uint64_t words[S];
+            uint64_t limbs[L];
+            for (size_t j = 0; j != S; ++j)
+                words[j] = x[done + lane][j];
+            to_limbs<S>(limbs, words);
+            for (size_t k = 0; k != L; ++k)
+                a[k][lane] = limbs[k];
+            for (size_t j = 0; j != S; ++j)
+                words[j] = y[done + lane][j];
+            to_limbs<S>(limbs, words);
+            for (size_t k = 0; k != L; ++k)
+                b[k][lane] = limbs[k];
+        }
+
+        __m512i va[L];
+        __m512i vb[L];
+        for (size_t k = 0; k != L; ++k)
+        {
+            va[k] = _mm512_load_si512(a[k]);
+            vb[k] = _mm512_load_si512(b[k]);
+        }
+
+        // The limbs of t are not normalized: they accumulate up to 2L 104-bit product halves,
+        // what fits 64-bit lanes for the supported sizes.
+        __m512i t[L + 1];
+        for (auto& v : t)
+            v = zero;
+        for (size_t i = 0; i != L; ++i)
+        {
+            for (size_t j = 0; j != L; ++j)
+            {
+                t[j] = _mm512_madd52lo_epu64(t[j], va[j], vb[i]);
+                t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], va[j], vb[i]);
+            }
+
+            // The multiplication uses only the low 52 bits of t[0].
+            auto q = _mm512_madd52lo_epu64(zero, t[0], minv);
+            if (i == L - 1)
+                q = _mm512_and_si512(q, mask_last);
+
+            for (size_t j = 0; j != L; ++j)
+            {
+                t[j] = _mm512_madd52lo_epu64(t[j], m[j], q);
+                t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], m[j], q);
+            }
+
+            if (i != L - 1)
+            {
+                // The low 52 bits of t[0] are 0 now. Shift t down by one limb.
+                t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+                for (size_t j = 0; j != L; ++j)
+                    t[j] = t[j + 1];
+                t[L] = zero;
+            }
+        }
+
+        // Normalize the limbs and shift t down by the LAST_BITS (these are 0 now).
+        for (size_t j = 0; j != L; ++j)
+        {
+            t[j + 1] = _mm512_add_epi64(t[j + 1], _mm512_srli_epi64(t[j], 52));
+            t[j] = _mm512_and_si512(t[j], mask52);
+        }
+        for (size_t j = 0; j != L; ++j)
+        {
+            t[j] = _mm512_or_si512(_mm512_srli_epi64(t[j], LAST_BITS),
+                _mm512_and_si512(_mm512_slli_epi64(t[j + 1], 52 - LAST_BITS), mask52));
+        }
+
+        // The result t < 2mod. Subtract the modulus if t >= mod.
+        __m512i d[L];
+        auto borrow = zero;
+        for (size_t j = 0; j != L; ++j)
+        {
+            const auto v = _mm512_sub_epi64(_mm512_sub_epi64(t[j], m[j]), borrow);
+            borrow = _mm512_srli_epi64(v, 63);
+            d[j] = _mm512_and_si512(v, mask52);
+        }
+        const auto ge = _mm512_cmpeq_epi64_mask(borrow, zero);
+
+        alignas(64) uint64_t c[L][LANES];
+        for (size_t k = 0; k != L; ++k)
+            _mm512_store_si512(c[k], _mm512_mask_blend_epi64(ge, t[k], d[k]));
+
+        for (size_t lane = 0; lane != LANES; ++lane)
+        {
+            uint64_t limbs[L];
+            uint64_t words[S];
+            for (size_t k = 0; k != L; ++k)
+                limbs[k] = c[k][lane];
+            from_limbs<S>(words, limbs);
+            for (size_t j = 0; j != S; ++j)
+                r[done + lane][j] = words[j];
+        }
+    }
+    return done;
+}
+}  // namespace ifma
+
+__attribute__((constructor)) void select_mul_backend() noexcept
+{
+    const auto& cpu = cpu_features();
+    if (!cpu.bmi2 || !cpu.adx)
+        return;
+    best_mul_backend = MulBackend::adx;
+
+    // The IFMA implementation processes full batches of LANES values only. The rest is left
+    // to the ADX implementation, all CPUs with IFMA support ADX.
+    if (cpu.avx512ifma)
+        best_mul_backend = MulBackend::ifma;
+
+    mul_backend = best_mul_backend;
+}
+
+#endif
+
+template <typename UintT>
+void mul_batch_impl(const ModArith<UintT>& arith, uint64_t mod_inv, UintT* r, const UintT* x,
+    const UintT* y, size_t n) noexcept
+{
+#if defined(__x86_64__)
+    switch (mul_backend)
+    {
+    case MulBackend::ifma:
+    {
+        const auto done = ifma::mul_batch(arith.mod, mod_inv, r, x, y, n);
+        mul_batch_adx(arith.mod, mod_inv, r + done, x + done, y + done, n - done);
+        return;
+    }
+    case MulBackend::adx:
+        mul_batch_adx(arith.mod, mod_inv, r, x, y, n);
+        return;
+    case MulBackend::portable:
+        break;
+    }
+#else
+    (void)mod_inv;
+#endif
+    mul_batch_portable(arith, r, x, y, n);
+}
+}  // namespace
+
+const char* mul_batch_implementation() noexcept
+{
+    return MUL_BACKEND_NAMES[static_cast<size_t>(mul_backend)];
+}
+
+bool set_mul_batch_implementation(std::string_view name) noexcept
+{
+    for (size_t i = 0; i <= static_cast<size_t>(best_mul_backend); ++i)
+    {
+        if (name == MUL_BACKEND_NAMES[i])
+        {
+            mul_backend = static_cast<MulBackend>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <>
+void ModArith<intx::uint256>::mul_batch(std::span<intx::uint256> r,
+    std::span<const intx::uint256> x, std::span<const intx::uint256> y) const noexcept
+{
+    assert(r.size() == x.size() && r.size() == y.size());
+    mul_batch_impl(*this, m_mod_inv, r.data(), x.data(), y.data(), r.size());
+}
+
+template <>
+void ModArith<intx::uint384>::mul_batch(std::span<intx::uint384> r,
+    std::span<const intx::uint384> x, std::span<const intx::uint384> y) const noexcept
+{
+    assert(r.size() == x.size() && r.size() == y.size());
+    mul_batch_impl(*this, m_mod_inv, r.data(), x.data(), y.data(), r.size());
+}
+}  // namespace evmmax
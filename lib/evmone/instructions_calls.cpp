@@ -6,6 +6,10 @@
 #include "eof.hpp"
 #include "instructions.hpp"
 
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
 constexpr int64_t MIN_RETAINED_GAS = 5000;
 constexpr int64_t MIN_CALLEE_GAS = 2300;
 constexpr int64_t CALL_VALUE_COST = 9000;
@@ -43,6 +47,54 @@ inline std::variant<evmc::address, Result> get_target_address(
 
     return *delegate_addr;
 }
+
+/// The size from which the call output is copied with the non-temporal stores
+/// (roughly the L2 cache size).
+constexpr size_t NON_TEMPORAL_COPY_THRESHOLD = 512 * 1024;
+
+/// Copies the call output to the memory.
+///
+/// The output may reference the input in the memory (e.g. the identity precompile)
+/// so the ranges may overlap. The large non-overlapping copies use the non-temporal (streaming)
+/// stores on x86-64: this avoids reading the destination cache lines before overwriting them
+/// and does not evict the working set from the cache.
+void copy_call_output(uint8_t* dst, const uint8_t* src, size_t size) noexcept
+{
+#if defined(__x86_64__)
+    const auto d_addr = reinterpret_cast<uintptr_t>(dst);
+    const auto s_addr = reinterpret_cast<uintptr_t>(src);
+    const bool overlap = d_addr < s_addr + size && s_addr < d_addr + size;
+    if (size >= NON_TEMPORAL_COPY_THRESHOLD && !overlap)
+    {
+        static constexpr size_t V = sizeof(__m128i);
+
+        // Copy the head with the regular stores to align the destination.
+        const auto head = static_cast<size_t>(-d_addr % V);
+        std::memcpy(dst, src, head);
+
+        size_t i = head;
+        for (; i + 4 * V <= size; i += 4 * V)
+        {
+            const auto* const s = reinterpret_cast<const __m128i*>(&src[i]);
+            auto* const d = reinterpret_cast<__m128i*>(&dst[i]);
+            const auto v0 = _mm_loadu_si128(&s[0]);
+            const auto v1 = _mm_loadu_si128(&s[1]);
+            const auto v2 = _mm_loadu_si128(&s[2]);
+            const auto v3 = _mm_loadu_si128(&s[3]);
+            _mm_stream_si128(&d[0], v0);
+            _mm_stream_si128(&d[1], v1);
+            _mm_stream_si128(&d[2], v2);
+            _mm_stream_si128(&d[3], v3);
+        }
+        std::memcpy(&dst[i], &src[i], size - i);
+
+        // The non-temporal stores are weakly ordered: make them visible before the later stores.
+        _mm_sfence();
+        return;
+    }
+#endif
+    std::memmove(dst, src, size);
+}
 }  // namespace
 
 /// Converts an opcode to matching EVMC call kind.
@@ -173,7 +225,7 @@ Result call_impl(StackTop stack, int64_t gas_left, ExecutionState& state) noexce
     stack.top() = result.status_code == EVMC_SUCCESS;
 
     if (const auto copy_size = std::min(output_size, result.output_size); copy_size > 0)
-        std::memcpy(&state.memory[output_offset], result.output_data, copy_size);
+        copy_call_output(&state.memory[output_offset], result.output_data, copy_size);
 
     const auto gas_used = msg.gas - result.gas_left;
     gas_left -= gas_used;
@@ -3,29 +3,50 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "blake2b.hpp"
+#include <evmmax/cpu_features.hpp>
+#include <algorithm>
 #include <array>
 #include <bit>
 
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
 namespace evmone::crypto
 {
-void blake2b_compress(
-    uint32_t rounds, uint64_t h[8], const uint64_t m[16], const uint64_t t[2], bool last) noexcept
+namespace
 {
-    // Message Schedule SIGMA.
-    // https://datatracker.ietf.org/doc/html/rfc7693#section-2.7
-    static constexpr uint8_t sigma[10][16]{
-        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
-        {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
-        {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
-        {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
-        {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
-        {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
-        {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
-        {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
-        {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
-    };
+// Message Schedule SIGMA.
+// https://datatracker.ietf.org/doc/html/rfc7693#section-2.7
+constexpr uint8_t sigma[10][16]{
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+};
+
+// Initialization Vector.
+// https://datatracker.ietf.org/doc/html/rfc7693#section-2.6
+constexpr uint64_t iv[8]{
+    0x6a09e667f3bcc908,
+    0xbb67ae8584caa73b,
+    0x3c6ef372fe94f82b,
+    0xa54ff53a5f1d36f1,
+    0x510e527fade682d1,
+    0x9b05688c2b3e6c1f,
+    0x1f83d9abfb41bd6b,
+    0x5be0cd19137e2179,
+};
 
+void blake2b_compress_generic(
+    uint32_t rounds, uint64_t h[8], const uint64_t m[16], const uint64_t t[2], bool last) noexcept
+{
     // Mixing Function G.
     // https://datatracker.ietf.org/doc/html/rfc7693#section-3.1
     //
@@ -45,12 +66,11 @@ void blake2b_compress(
 
     // Initialize local work vector v[0..15].
     uint64_t v[16]{h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],  // First half from state.
-        0x6a09e667f3bcc908, 0xbb67ae8584caa73b,                     // Second half from IV.
-        0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
-        0x510e527fade682d1 ^ t[0],                  // Low word of the offset.
-        0x9b05688c2b3e6c1f ^ t[1],                  // High word.
-        0x1f83d9abfb41bd6b ^ (0 - uint64_t{last}),  // Last block flag? Invert all bits.
-        0x5be0cd19137e2179};
+        iv[0], iv[1], iv[2], iv[3],                                 // Second half from IV.
+        iv[4] ^ t[0],                   // Low word of the offset.
+        iv[5] ^ t[1],                   // High word.
+        iv[6] ^ (0 - uint64_t{last}),  // Last block flag? Invert all bits.
+        iv[7]};
 
     // Cryptographic mixing.
     for (size_t i = 0; i < rounds; ++i)
@@ -71,4 +91,115 @@ void blake2b_compress(
     for (size_t i = 0; i < 8; ++i)  // XOR the two halves.
         h[i] ^= v[i] ^ v[i + 8];
 }
+
+#if defined(__x86_64__)
+
+// NOLINTBEGIN(portability-simd-intrinsics)
+// NOLINTBEGIN(cppcoreguidelines-pro-type-cstyle-cast)
+
+/// The mixing function G applied to the four columns (or diagonals) at once:
+/// the lane i of the rows a, b, c, d holds the words of the i-th G invocation.
+__attribute__((target("avx2"))) inline void g_x4(
+    __m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y) noexcept
+{
+    // The byte shuffles for the 64-bit rotations by 24 and 16.
+    const auto rotr24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3,
+        4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+    const auto rotr16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2,
+        3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+    d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2, 3, 0, 1));
+    c = _mm256_add_epi64(c, d);
+    b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rotr24);
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+    d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rotr16);
+    c = _mm256_add_epi64(c, d);
+    b = _mm256_xor_si256(b, c);
+    b = _mm256_or_si256(_mm256_srli_epi64(b, 63), _mm256_add_epi64(b, b));
+}
+
+/// BLAKE2b compress function F using AVX2.
+///
+/// The working vector v[0..15] is kept in 4 rows of 4 words. The column step of the round
+/// mixes the rows lane-wise. For the diagonal step the rows b, c, d are rotated
+/// by 1, 2, 3 lanes so that the diagonals are aligned in the lanes, and rotated back after.
+__attribute__((target("avx2"))) void blake2b_compress_avx2(
+    uint32_t rounds, uint64_t h[8], const uint64_t m[16], const uint64_t t[2], bool last) noexcept
+{
+    const auto h0 = _mm256_loadu_si256((const __m256i*)&h[0]);
+    const auto h1 = _mm256_loadu_si256((const __m256i*)&h[4]);
+    auto a = h0;
+    auto b = h1;
+    auto c = _mm256_loadu_si256((const __m256i*)&iv[0]);
+    auto d = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&iv[4]),
+        _mm256_setr_epi64x(static_cast<long long>(t[0]), static_cast<long long>(t[1]),
+            -static_cast<long long>(last), 0));
+
+    // The message words for the 10 distinct rounds, selected by the sigma permutations:
+    // x and y of the column step, x and y of the diagonal step.
+    // The message block is not used (and may be null) for 0 rounds.
+    __m256i msg[std::size(sigma)][4];
+    const auto num_distinct_rounds = std::min(size_t{rounds}, std::size(sigma));
+    for (size_t r = 0; r < num_distinct_rounds; ++r)
+    {
+        const auto& s = sigma[r];
+        for (size_t k = 0; k < 4; ++k)
+        {
+            // The x word of the lane i is at s[8⋅(k/2) + 2⋅i], the y word is next to it.
+            const auto o = 8 * (k / 2) + k % 2;
+            msg[r][k] = _mm256_setr_epi64x(static_cast<long long>(m[s[o]]),
+                static_cast<long long>(m[s[o + 2]]), static_cast<long long>(m[s[o + 4]]),
+                static_cast<long long>(m[s[o + 6]]));
+        }
+    }
+
+    for (size_t i = 0, r = 0; i < rounds; ++i)
+    {
+        g_x4(a, b, c, d, msg[r][0], msg[r][1]);
+
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));
+
+        g_x4(a, b, c, d, msg[r][2], msg[r][3]);
+
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+
+        if (++r == std::size(sigma))
+            r = 0;
+    }
+
+    // XOR the two halves.
+    _mm256_storeu_si256((__m256i*)&h[0], _mm256_xor_si256(h0, _mm256_xor_si256(a, c)));
+    _mm256_storeu_si256((__m256i*)&h[4], _mm256_xor_si256(h1, _mm256_xor_si256(b, d)));
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-cstyle-cast)
+// NOLINTEND(portability-simd-intrinsics)
+
+#endif
+
+/// The implementation of blake2b_compress() selected for the CPU.
+void (*blake2b_compress_best)(uint32_t rounds, uint64_t h[8], const uint64_t m[16],
+    const uint64_t t[2], bool last) noexcept = blake2b_compress_generic;
+
+#if defined(__x86_64__)
+
+__attribute__((constructor)) void select_blake2b_implementation() noexcept
+{
+    if (evmmax::cpu_features().avx2)
+        blake2b_compress_best = blake2b_compress_avx2;
+}
+
+#endif
+}  // namespace
+
+void blake2b_compress(
+    uint32_t rounds, uint64_t h[8], const uint64_t m[16], const uint64_t t[2], bool last) noexcept
+{
+    blake2b_compress_best(rounds, h, m, t, last);
+}
 }  // namespace evmone::crypto
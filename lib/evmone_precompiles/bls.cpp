@@ -1,7 +1,11 @@
 #include "bls.hpp"
 #include <blst.h>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace evmone::crypto::bls
@@ -89,8 +93,266 @@ void store(uint8_t _rx[128], const blst_fp2& _x) noexcept
     store(&_rx[64], _x.fp[1]);
 }
 
+/// The maximum number of points for which the MSM is computed as the sum of the individual
+/// scalar multiplications. For such small inputs the Pippenger's setup and bucket
+/// accumulation costs more than it saves.
+constexpr size_t MSM_SMALL_MAX_POINTS = 4;
+
+/// The memory for the MSM inputs, the Pippenger's scratch space and the partial results
+/// of the parallel MSM.
+///
+/// An instance is kept per thread and reused between MSM calls. The buffers grow to the size
+/// of the largest MSM computed by the thread so the repeated calls do not allocate.
+template <typename Point, typename AffinePoint>
+struct MsmArena
+{
+    std::vector<AffinePoint> points;
+    std::vector<const AffinePoint*> point_ptrs;
+    std::vector<blst_scalar> scalars;
+    std::vector<const uint8_t*> scalar_ptrs;
+    std::vector<limb_t> scratch;
+    std::vector<Point> partial;
+
+    /// Clears the inputs of the previous MSM, keeping the allocated memory.
+    void clear() noexcept
+    {
+        points.clear();
+        point_ptrs.clear();
+        scalars.clear();
+        scalar_ptrs.clear();
+    }
+
+    /// Fills the pointer arrays as expected by the blst MSM functions.
+    void make_ptrs()
+    {
+        for (const auto& p : points)
+            point_ptrs.emplace_back(&p);
+        for (const auto& s : scalars)
+            scalar_ptrs.emplace_back(s.b);
+    }
+};
+
+/// The minimal number of points of an MSM chunk computed by a single thread.
+/// Below this the Pippenger's algorithm loses its advantage over the individual multiplications.
+constexpr size_t MSM_MIN_CHUNK_POINTS = 32;
+
+/// The pool of worker threads for the parallel MSM.
+///
+/// The pool runs a single job at a time: the chunks [0, n) of the job are taken one by one
+/// by the workers and the calling thread. Running a job does not allocate.
+class WorkerPool
+{
+    /// Serializes the jobs of the concurrent callers.
+    std::mutex m_run_mutex;
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+    void (*m_fn)(void* ctx, size_t i) noexcept = nullptr;
+    void* m_ctx = nullptr;
+    size_t m_num_chunks = 0;
+    size_t m_next_chunk = 0;
+    size_t m_num_done = 0;
+    bool m_stop = false;
+    std::vector<std::thread> m_workers;
+
+    /// Runs the chunks of the current job until all are taken.
+    /// The lock is released while a chunk is computed.
+    void run_chunks(std::unique_lock<std::mutex>& lock) noexcept
+    {
+        while (m_next_chunk < m_num_chunks)
+        {
+            const auto fn = m_fn;
+            const auto ctx = m_ctx;
+            const auto i = m_next_chunk++;
+            lock.unlock();
+            fn(ctx, i);
+            lock.lock();
+            if (++m_num_done == m_num_chunks)
+                m_done_cv.notify_one();
+        }
+    }
+
+    void work() noexcept
+    {
+        std::unique_lock lock{m_mutex};
+        while (true)
+        {
+            m_work_cv.wait(lock, [this] { return m_stop || m_next_chunk < m_num_chunks; });
+            if (m_stop)
+                return;
+            run_chunks(lock);
+        }
+    }
+
+    void stop() noexcept
+    {
+        {
+            const std::lock_guard lock{m_mutex};
+            m_stop = true;
+        }
+        m_work_cv.notify_all();
+        for (auto& w : m_workers)
+            w.join();
+    }
+
+public:
+    /// Starts the workers. Throws std::system_error if a thread cannot be started.
+    explicit WorkerPool(size_t num_workers)
+    {
+        m_workers.reserve(num_workers);
+        try
+        {
+            for (size_t i = 0; i < num_workers; ++i)
+                m_workers.emplace_back([this] { work(); });
+        }
+        catch (...)
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ~WorkerPool() { stop(); }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// Runs fn(i) for i in [0, n) and waits for all of them to finish.
+    /// Returns false without running anything if the pool is busy with another job.
+    template <typename Fn>
+    bool try_run(size_t n, Fn& fn) noexcept
+    {
+        const std::unique_lock run_lock{m_run_mutex, std::try_to_lock};
+        if (!run_lock.owns_lock())
+            return false;
+
+        std::unique_lock lock{m_mutex};
+        m_fn = [](void* ctx, size_t i) noexcept { (*static_cast<Fn*>(ctx))(i); };
+        m_ctx = &fn;
+        m_num_chunks = n;
+        m_next_chunk = 0;
+        m_num_done = 0;
+        m_work_cv.notify_all();
+
+        run_chunks(lock);
+        m_done_cv.wait(lock, [this] { return m_num_done == m_num_chunks; });
+        m_num_chunks = 0;
+        m_next_chunk = 0;
+        return true;
+    }
+};
+
+/// The configuration of the parallel MSM and its worker pool.
+struct MsmParallelism
+{
+    std::mutex mutex;
+    size_t num_threads = 1;
+    size_t min_points = 0;
+    std::shared_ptr<WorkerPool> pool;
+};
+
+MsmParallelism& msm_parallelism() noexcept
+{
+    static MsmParallelism p;
+    return p;
+}
+
+/// The split of the MSM computation into chunks.
+struct MsmSplit
+{
+    std::shared_ptr<WorkerPool> pool;
+    size_t num_chunks = 1;
+};
+
+/// Returns the worker pool and the number of chunks the MSM of npoints should be split into.
+MsmSplit msm_split(size_t npoints) noexcept
+{
+    auto& p = msm_parallelism();
+    const std::lock_guard lock{p.mutex};
+    if (p.num_threads <= 1 || npoints < p.min_points)
+        return {nullptr, 1};
+    return {p.pool, std::min(p.num_threads, npoints / MSM_MIN_CHUNK_POINTS)};
+}
+
+void mult_pippenger(blst_p1& out, const blst_p1_affine* const* points,
+    const uint8_t* const* scalars, size_t npoints, std::vector<limb_t>& scratch) noexcept
+{
+    scratch.resize(blst_p1s_mult_pippenger_scratch_sizeof(npoints) / sizeof(limb_t));
+    blst_p1s_mult_pippenger(&out, points, npoints, scalars, 256, scratch.data());
+}
+
+void mult_pippenger(blst_p2& out, const blst_p2_affine* const* points,
+    const uint8_t* const* scalars, size_t npoints, std::vector<limb_t>& scratch) noexcept
+{
+    scratch.resize(blst_p2s_mult_pippenger_scratch_sizeof(npoints) / sizeof(limb_t));
+    blst_p2s_mult_pippenger(&out, points, npoints, scalars, 256, scratch.data());
+}
+
+void add(blst_p1& out, const blst_p1& p) noexcept
+{
+    blst_p1_add_or_double(&out, &out, &p);
+}
+
+void add(blst_p2& out, const blst_p2& p) noexcept
+{
+    blst_p2_add_or_double(&out, &out, &p);
+}
+
+/// Computes the MSM of the arena inputs with the Pippenger's algorithm.
+///
+/// If the parallel MSM is enabled and the input is big enough, the points are split into
+/// the chunks of consecutive points computed by the worker pool threads. The partial results
+/// are added in the chunk order. If the pool is busy with the MSM of another thread,
+/// the MSM is computed by the calling thread only.
+template <typename Point, typename AffinePoint>
+Point msm_pippenger(MsmArena<Point, AffinePoint>& arena) noexcept
+{
+    arena.make_ptrs();
+    const auto npoints = arena.points.size();
+
+    Point out;
+    const auto split = msm_split(npoints);
+    const auto num_chunks = split.num_chunks;
+    if (num_chunks > 1)
+    {
+        arena.partial.resize(num_chunks);
+        auto compute_chunk = [&arena, npoints, num_chunks](size_t i) noexcept {
+            thread_local std::vector<limb_t> scratch;
+            const auto begin = npoints * i / num_chunks;
+            const auto end = npoints * (i + 1) / num_chunks;
+            mult_pippenger(arena.partial[i], &arena.point_ptrs[begin], &arena.scalar_ptrs[begin],
+                end - begin, scratch);
+        };
+        if (split.pool->try_run(num_chunks, compute_chunk))
+        {
+            out = arena.partial[0];
+            for (size_t i = 1; i < num_chunks; ++i)
+                add(out, arena.partial[i]);
+            return out;
+        }
+    }
+
+    mult_pippenger(out, arena.point_ptrs.data(), arena.scalar_ptrs.data(), npoints, arena.scratch);
+    return out;
+}
 }  // namespace
 
+void set_msm_parallelism(size_t num_threads, size_t min_points)
+{
+    num_threads = std::max(num_threads, size_t{1});
+
+    // Start the new workers first so the configuration is unchanged if this fails.
+    auto pool = num_threads > 1 ? std::make_shared<WorkerPool>(num_threads - 1) : nullptr;
+
+    auto& p = msm_parallelism();
+    const std::lock_guard lock{p.mutex};
+    p.num_threads = num_threads;
+    p.min_points = min_points;
+    // The MSMs in progress keep the previous pool alive.
+    std::swap(p.pool, pool);
+}
+
 [[nodiscard]] bool g1_add(uint8_t _rx[64], uint8_t _ry[64], const uint8_t _x0[64],
     const uint8_t _y0[64], const uint8_t _x1[64], const uint8_t _y1[64]) noexcept
 {
@@ -196,17 +458,9 @@ void store(uint8_t _rx[128], const blst_fp2& _x) noexcept
 {
     constexpr auto SINGLE_ENTRY_SIZE = (64 * 2 + 32);
     assert(size % SINGLE_ENTRY_SIZE == 0);
-    const auto npoints = size / SINGLE_ENTRY_SIZE;
 
-    std::vector<blst_p1_affine> p1_affines;
-    std::vector<const blst_p1_affine*> p1_affine_ptrs;
-    p1_affines.reserve(npoints);
-    p1_affine_ptrs.reserve(npoints);
-
-    std::vector<blst_scalar> scalars;
-    std::vector<const uint8_t*> scalars_ptrs;
-    scalars.reserve(npoints);
-    scalars_ptrs.reserve(npoints);
+    thread_local MsmArena<blst_p1, blst_p1_affine> arena;
+    arena.clear();
 
     const auto end = _xycs + size;
     for (auto ptr = _xycs; ptr != end; ptr += SINGLE_ENTRY_SIZE)
@@ -222,28 +476,35 @@ void store(uint8_t _rx[128], const blst_fp2& _x) noexcept
         if (blst_p1_affine_is_inf(&*p_affine))
             continue;
 
-        const auto& p = p1_affines.emplace_back(*p_affine);
-        p1_affine_ptrs.emplace_back(&p);
-
-        blst_scalar scalar;
-        blst_scalar_from_bendian(&scalar, &ptr[128]);
-        const auto& s = scalars.emplace_back(scalar);
-        scalars_ptrs.emplace_back(s.b);
+        arena.points.emplace_back(*p_affine);
+        blst_scalar_from_bendian(&arena.scalars.emplace_back(), &ptr[128]);
     }
 
-    if (p1_affine_ptrs.empty())
+    const auto npoints = arena.points.size();
+    if (npoints == 0)
     {
         std::memset(_rx, 0, 64);
         std::memset(_ry, 0, 64);
         return true;
     }
 
-    const auto scratch_size =
-        blst_p1s_mult_pippenger_scratch_sizeof(p1_affine_ptrs.size()) / sizeof(limb_t);
-    const auto scratch_space = std::make_unique_for_overwrite<limb_t[]>(scratch_size);
     blst_p1 out;
-    blst_p1s_mult_pippenger(&out, p1_affine_ptrs.data(), p1_affine_ptrs.size(), scalars_ptrs.data(),
-        256, scratch_space.get());
+    if (npoints <= MSM_SMALL_MAX_POINTS)
+    {
+        out = {};  // Point at infinity.
+        for (size_t i = 0; i < npoints; ++i)
+        {
+            blst_p1 p;
+            blst_p1_from_affine(&p, &arena.points[i]);
+            blst_p1 r;
+            blst_p1_mult(&r, &p, arena.scalars[i].b, 256);
+            blst_p1_add_or_double(&out, &out, &r);
+        }
+    }
+    else
+    {
+        out = msm_pippenger<blst_p1>(arena);
+    }
 
     blst_p1_affine result;
     blst_p1_to_affine(&result, &out);
@@ -258,17 +519,9 @@ void store(uint8_t _rx[128], const blst_fp2& _x) noexcept
 {
     constexpr auto SINGLE_ENTRY_SIZE = (128 * 2 + 32);
     assert(size % SINGLE_ENTRY_SIZE == 0);
-    const auto npoints = size / SINGLE_ENTRY_SIZE;
 
-    std::vector<blst_p2_affine> p2_affines;
-    std::vector<const blst_p2_affine*> p2_affine_ptrs;
-    p2_affines.reserve(npoints);
-    p2_affine_ptrs.reserve(npoints);
-
-    std::vector<blst_scalar> scalars;
-    std::vector<const uint8_t*> scalars_ptrs;
-    scalars.reserve(npoints);
-    scalars_ptrs.reserve(npoints);
+    thread_local MsmArena<blst_p2, blst_p2_affine> arena;
+    arena.clear();
 
     const auto end = _xycs + size;
     for (auto ptr = _xycs; ptr != end; ptr += SINGLE_ENTRY_SIZE)
@@ -284,28 +537,35 @@ void store(uint8_t _rx[128], const blst_fp2& _x) noexcept
         if (blst_p2_affine_is_inf(&*p_affine))
             continue;
 
-        const auto& p = p2_affines.emplace_back(*p_affine);
-        p2_affine_ptrs.emplace_back(&p);
-
-        blst_scalar scalar;
-        blst_scalar_from_bendian(&scalar, &ptr[256]);
-        const auto& s = scalars.emplace_back(scalar);
-        scalars_ptrs.emplace_back(s.b);
+        arena.points.emplace_back(*p_affine);
+        blst_scalar_from_bendian(&arena.scalars.emplace_back(), &ptr[256]);
     }
 
-    if (p2_affine_ptrs.empty())
+    const auto npoints = arena.points.size();
+    if (npoints == 0)
     {
         std::memset(_rx, 0, 128);
         std::memset(_ry, 0, 128);
         return true;
     }
 
-    const auto scratch_size =
-        blst_p2s_mult_pippenger_scratch_sizeof(p2_affine_ptrs.size()) / sizeof(limb_t);
-    const auto scratch_space = std::make_unique_for_overwrite<limb_t[]>(scratch_size);
     blst_p2 out;
-    blst_p2s_mult_pippenger(&out, p2_affine_ptrs.data(), p2_affine_ptrs.size(), scalars_ptrs.data(),
-        256, scratch_space.get());
+    if (npoints <= MSM_SMALL_MAX_POINTS)
+    {
+        out = {};  // Point at infinity.
+        for (size_t i = 0; i < npoints; ++i)
+        {
+            blst_p2 p;
+            blst_p2_from_affine(&p, &arena.points[i]);
+            blst_p2 r;
+            blst_p2_mult(&r, &p, arena.scalars[i].b, 256);
+            blst_p2_add_or_double(&out, &out, &r);
+        }
+    }
+    else
+    {
+        out = msm_pippenger<blst_p2>(arena);
+    }
 
     blst_p2_affine result;
     blst_p2_to_affine(&result, &out);
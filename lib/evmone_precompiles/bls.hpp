@@ -55,6 +55,16 @@ inline constexpr auto BLS_FIELD_MODULUS =
 [[nodiscard]] bool g2_msm(
     uint8_t _rx[128], uint8_t _ry[128], const uint8_t* _xycs, size_t size) noexcept;
 
+/// Configures the parallel computation of the big G1 and G2 MSMs.
+///
+/// The MSMs of at least @p min_points points are split into chunks of consecutive points
+/// computed by @p num_threads threads (the calling thread and the shared worker pool).
+/// The results are the same as of the single-threaded computation.
+/// By default, the MSM is computed by the calling thread only (@p num_threads 1).
+/// Throws std::system_error if the worker threads cannot be started; the previous
+/// configuration is kept then.
+void set_msm_parallelism(size_t num_threads, size_t min_points = 128);
+
 /// Maps field element of Fp to curve point on BLS12-381 curve G1 subgroup.
 ///
 /// Performs field Fp element check. Returns `false` if an element is not from the field.
@@ -3,14 +3,182 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "bn254.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <vector>
 
 namespace evmmax::bn254
 {
 namespace
 {
-constexpr ModArith Fp{FieldPrime};
+constexpr SparseModArith Fp{FieldPrime};
 constexpr auto B = Fp.to_mont(3);
 constexpr auto B3 = Fp.to_mont(3 * 3);
+
+/// The generator of the G1 group.
+constexpr Point G{1, 2};
+
+/// The cube root of unity in the field (in Montgomery form).
+/// The endomorphism φ(x, y) = (βx, y) is the multiplication by the λ cube root of unity mod N:
+/// φ(P) = [λ]P, where λ = 0x30644e72e131a029048b6e193fd84104cc37a73fec2bc5e9b8ca0b2d36636f23.
+constexpr auto Beta =
+    Fp.to_mont(0x30644e72e131a0295e6dd9e7e0acccb0c28f069fbb966e3de4bd44e5607cfd48_u256);
+
+/// The GLV decomposition parameters for the endomorphism φ (see Beta).
+constexpr ecc::GLVBasis<uint256> GLV{
+    .a1 = 0x6f4d8248eeb859fc8211bbeb7d4f1128_u256,
+    .minus_b1 = 0x89d3256894d213e3_u256,
+    .a2 = 0x89d3256894d213e3_u256,
+    .b2 = 0x6f4d8248eeb859fd0be4e1541221250b_u256,
+    .g1 = 0x24ccef014a773d2d25398fd0300ff6565_u256,
+    .g2 = 0x2d91d232ec7e0b3d7_u256,
+    .shift = 256,
+};
+
+/// The wNAF width for the scalar multiplication.
+constexpr int WNAF_WIDTH = 5;
+
+/// The maximum number of wNAF digits of the 128-bit scalar halves.
+constexpr size_t MAX_WNAF_SIZE = 130;
+
+/// The window width for the multiplication of the generator G with the precomputed table.
+constexpr int G_WINDOW_WIDTH = 6;
+
+/// The number of the signed windows of the scalars < N.
+/// The scalars are 254-bit so the top window digit is small and never produces a carry.
+constexpr size_t G_NUM_WINDOWS = (254 + G_WINDOW_WIDTH - 1) / G_WINDOW_WIDTH;
+
+/// The precomputed multiples [d·2^(W·j)]G for d in [1, 2^(W-1)] for every window j
+/// as affine points in Montgomery form. The table takes 86 KiB.
+struct GTable
+{
+    static constexpr size_t WINDOW_SIZE = size_t{1} << (G_WINDOW_WIDTH - 1);
+
+    std::array<std::array<Point, WINDOW_SIZE>, G_NUM_WINDOWS> windows;
+};
+
+/// Returns the G multiples table. It is built on the first use.
+const GTable& g_table() noexcept
+{
+    static const auto table = [] {
+        // Compute the multiples in projective coordinates
+        // and convert them all to affine coordinates with a single inversion.
+        std::vector<ecc::ProjPoint<uint256>> points;
+        points.reserve(G_NUM_WINDOWS * GTable::WINDOW_SIZE);
+        auto base = ecc::to_proj(Fp, G);
+        for (size_t j = 0; j < G_NUM_WINDOWS; ++j)
+        {
+            points.push_back(base);
+            for (size_t d = 1; d < GTable::WINDOW_SIZE; ++d)
+                points.push_back(ecc::add(Fp, points.back(), base, B3));
+            base = ecc::dbl(Fp, points.back(), B3);  // [2^W]base = [2·WINDOW_SIZE]base.
+        }
+
+        std::vector<Point> affine_points(points.size());
+        ecc::batch_to_affine(Fp, field_inv, points, affine_points);
+
+        auto t = std::make_unique<GTable>();
+        for (size_t i = 0; i < affine_points.size(); ++i)
+            t->windows[i / GTable::WINDOW_SIZE][i % GTable::WINDOW_SIZE] = affine_points[i];
+        return t;
+    }();
+    return *table;
+}
+
+/// Computes [k]G for k < N using the precomputed table of the G multiples.
+///
+/// The scalar is recoded to the signed fixed-width windows so the multiplication takes
+/// a single mixed addition per window and no doublings.
+/// The execution time depends on the scalar.
+ecc::ProjPoint<uint256> mul_g(uint256 k) noexcept
+{
+    static constexpr auto HALF = int{1} << (G_WINDOW_WIDTH - 1);
+    static constexpr auto MASK = (uint64_t{1} << G_WINDOW_WIDTH) - 1;
+
+    const auto& gt = g_table();
+
+    ecc::ProjPoint<uint256> r;
+    int carry = 0;
+    for (size_t j = 0; j < G_NUM_WINDOWS; ++j)
+    {
+        // The digit d in [-2^(W-1), 2^(W-1)].
+        auto d = static_cast<int>(k[0] & MASK) + carry;
+        k >>= G_WINDOW_WIDTH;
+        carry = d > HALF ? 1 : 0;
+        d -= carry * 2 * HALF;
+
+        if (d != 0)
+        {
+            auto e = gt.windows[j][static_cast<size_t>(d < 0 ? -d : d) - 1];
+            if (d < 0)
+                e.y = Fp.sub(0, e.y);
+            r = ecc::add(Fp, r, e, B3);
+        }
+    }
+    assert(carry == 0);
+    return r;
+}
+
+/// Computes [k]P for k < N using the GLV decomposition: [k1]P + [k2]φ(P).
+///
+/// The two ~128-bit scalar multiplications are interleaved so they share the doublings
+/// and the scalars are in the wNAF form. The execution time depends on the scalar.
+ecc::ProjPoint<uint256> mul_glv(const ecc::ProjPoint<uint256>& p, const uint256& k) noexcept
+{
+    static constexpr size_t TABLE_SIZE = size_t{1} << (WNAF_WIDTH - 2);
+
+    // Odd multiples of P and φ(P).
+    std::array<ecc::ProjPoint<uint256>, TABLE_SIZE> pt;
+    std::array<ecc::ProjPoint<uint256>, TABLE_SIZE> pt_endo;
+    pt[0] = p;
+    const auto p2 = ecc::dbl(Fp, p, B3);
+    for (size_t i = 1; i < TABLE_SIZE; ++i)
+        pt[i] = ecc::add(Fp, pt[i - 1], p2, B3);
+    for (size_t i = 0; i < TABLE_SIZE; ++i)
+        pt_endo[i] = {Fp.mul(pt[i].x, Beta), pt[i].y, pt[i].z};
+
+    const auto sk = ecc::split_scalar(GLV, k);
+    if (sk.k1_neg)
+    {
+        for (auto& e : pt)
+            e.y = Fp.sub(0, e.y);
+    }
+    if (sk.k2_neg)
+    {
+        for (auto& e : pt_endo)
+            e.y = Fp.sub(0, e.y);
+    }
+
+    std::array<int8_t, MAX_WNAF_SIZE> digits;
+    std::array<int8_t, MAX_WNAF_SIZE> endo_digits;
+    const auto size = ecc::to_wnaf<WNAF_WIDTH>(digits, sk.k1);
+    const auto endo_size = ecc::to_wnaf<WNAF_WIDTH>(endo_digits, sk.k2);
+
+    // Adds the table entry for the wNAF digit d (if not zero) to r.
+    const auto add_digit = [](ecc::ProjPoint<uint256>& r, const auto& table, int d) noexcept {
+        if (d > 0)
+            r = ecc::add(Fp, r, table[static_cast<size_t>(d) / 2], B3);
+        else if (d < 0)
+        {
+            auto e = table[static_cast<size_t>(-d) / 2];
+            e.y = Fp.sub(0, e.y);
+            r = ecc::add(Fp, r, e, B3);
+        }
+    };
+
+    ecc::ProjPoint<uint256> r;
+    for (size_t i = std::max(size, endo_size); i-- != 0;)
+    {
+        r = ecc::dbl(Fp, r, B3);
+        if (i < size)
+            add_digit(r, pt, digits[i]);
+        if (i < endo_size)
+            add_digit(r, pt_endo, endo_digits[i]);
+    }
+    return r;
+}
 }  // namespace
 
 bool validate(const Point& pt) noexcept
@@ -37,7 +205,7 @@ Point add(const Point& pt1, const Point& pt2) noexcept
     // b3 == 9 for y^2 == x^3 + 3
     const auto r = ecc::add(Fp, ecc::to_proj(Fp, pt1), ecc::to_proj(Fp, pt2), B3);
 
-    return ecc::to_affine(Fp, field_inv, r);
+    return ecc::to_affine(Fp, ecc::inv, r);
 }
 
 Point mul(const Point& pt, const uint256& c) noexcept
@@ -45,12 +213,15 @@ Point mul(const Point& pt, const uint256& c) noexcept
     if (pt.is_inf())
         return pt;
 
-    if (c == 0)
+    // The bn254 curve has the prime order (the cofactor is 1)
+    // so for any valid point [c]P = [c mod N]P.
+    const auto k = c % Order;
+    if (k == 0)
         return {};
 
-    const auto pr = ecc::mul(Fp, ecc::to_proj(Fp, pt), c, B3);
+    const auto pr = pt == G ? mul_g(k) : mul_glv(ecc::to_proj(Fp, pt), k);
 
-    return ecc::to_affine(Fp, field_inv, pr);
+    return ecc::to_affine(Fp, ecc::inv, pr);
 }
 
 uint256 field_inv(const ModArith<uint256>& m, const uint256& x) noexcept
@@ -16,6 +16,10 @@ using namespace intx;
 inline constexpr auto FieldPrime =
     0x30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47_u256;
 
+/// The bn254 curve group order (N).
+inline constexpr auto Order =
+    0x30644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000001_u256;
+
 using Point = ecc::Point<uint256>;
 using ExtPoint = ecc::Point<std::pair<uint256, uint256>>;
 
@@ -38,6 +42,8 @@ Point add(const Point& pt1, const Point& pt2) noexcept;
 /// Scalar multiplication in bn254 curve group.
 ///
 /// Computes [c]P for a point in affine coordinate on the bn254 curve,
+/// The point must be valid (see validate()). This is not constant-time: the execution time
+/// depends on the value of the scalar.
 Point mul(const Point& pt, const uint256& c) noexcept;
 
 /// ate paring implementation for bn254 curve according to https://eips.ethereum.org/EIPS/eip-197
@@ -46,6 +52,29 @@ Point mul(const Point& pt, const uint256& c) noexcept;
 ///               followed by a point from twisted curve G2 group over extension field Fq^2.
 /// @return       `true` when  ∏e(vG2[i], vG1[i]) == 1 for i in [0, n] else `false`.
 ///               std::nullopt on error.
+///
+/// The validated G2 points are kept in the bounded process-wide cache (see g2_cache_stats()).
 std::optional<bool> pairing_check(std::span<const std::pair<Point, ExtPoint>> pairs) noexcept;
 
+/// The statistics of the process-wide cache of the validated G2 points used by pairing_check().
+struct G2CacheStats
+{
+    uint64_t hits = 0;    ///< The number of lookups of the cached G2 points.
+    uint64_t misses = 0;  ///< The number of lookups of the G2 points not in the cache.
+    size_t size = 0;      ///< The current number of the cached G2 points.
+
+    /// The fraction of lookups served by the cache.
+    [[nodiscard]] double hit_rate() const noexcept
+    {
+        const auto lookups = hits + misses;
+        return lookups != 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+/// Returns the statistics of the G2 points cache.
+G2CacheStats g2_cache_stats() noexcept;
+
+/// Removes all the G2 points from the cache and resets the statistics.
+void g2_cache_clear() noexcept;
+
 }  // namespace evmmax::bn254
@@ -4,6 +4,12 @@
 #pragma once
 
 #include <evmmax/evmmax.hpp>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 namespace evmmax::ecc
 {
@@ -72,6 +78,44 @@ struct JacPoint
 template <typename IntT>
 using InvFn = IntT (*)(const ModArith<IntT>&, const IntT& x) noexcept;
 
+/// Computes the modular inverse of x in Montgomery form with the generic safegcd algorithm.
+/// This matches the InvFn signature.
+template <typename IntT>
+inline IntT inv(const ModArith<IntT>& s, const IntT& x) noexcept
+{
+    return s.inv(x);
+}
+
+/// Inverts multiple field elements at once using Montgomery's trick.
+///
+/// The elements are in Montgomery form and are replaced with their inverses.
+/// This costs a single inversion @p inv and 3 multiplications per element.
+/// The zero elements are skipped and remain zero.
+template <typename IntT>
+void batch_inv(const ModArith<IntT>& s, InvFn<IntT> inv, std::span<IntT> xs) noexcept
+{
+    // The products of all preceding non-zero elements.
+    std::vector<IntT> prefix(xs.size());
+
+    auto acc = s.to_mont(1);
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        prefix[i] = acc;
+        if (xs[i] != 0)
+            acc = s.mul(acc, xs[i]);
+    }
+
+    auto acc_inv = inv(s, acc);
+    for (size_t i = xs.size(); i-- != 0;)
+    {
+        if (xs[i] == 0)
+            continue;
+        const auto x_inv = s.mul(acc_inv, prefix[i]);
+        acc_inv = s.mul(acc_inv, xs[i]);
+        xs[i] = x_inv;
+    }
+}
+
 /// Converts an affine point to a projected point with coordinates in Montgomery form.
 template <typename IntT>
 inline ProjPoint<IntT> to_proj(const ModArith<IntT>& s, const Point<IntT>& p) noexcept
@@ -92,9 +136,47 @@ inline Point<IntT> to_affine(
     return {s.from_mont(s.mul(p.x, z_inv)), s.from_mont(s.mul(p.y, z_inv))};
 }
 
-template <typename IntT, int A = 0>
-ProjPoint<IntT> add(const evmmax::ModArith<IntT>& s, const ProjPoint<IntT>& p,
-    const ProjPoint<IntT>& q, const IntT& b3) noexcept
+/// Converts multiple projected points to affine points with a single inversion (see batch_inv()).
+///
+/// Unlike to_affine(), the coordinates of the results remain in Montgomery form.
+/// The coordinates are multiplied by the inverses with ModArith::mul_batch().
+/// The points at infinity are converted to the affine "infinity" Point{}.
+template <typename IntT>
+void batch_to_affine(const ModArith<IntT>& s, InvFn<IntT> inv,
+    std::span<const ProjPoint<std::type_identity_t<IntT>>> points,
+    std::span<Point<std::type_identity_t<IntT>>> out) noexcept
+{
+    assert(out.size() == points.size());
+    const auto n = points.size();
+
+    // The z coordinates to be inverted followed by the x and y coordinates.
+    std::vector<IntT> coords(3 * n);
+    const auto z_inv = std::span{coords}.first(n);
+    const auto xs = std::span{coords}.subspan(n, n);
+    const auto ys = std::span{coords}.subspan(2 * n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        z_inv[i] = points[i].z;
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+    }
+    batch_inv(s, inv, z_inv);
+
+    // The multiplications by the inverses are independent: compute them in batches.
+    s.mul_batch(xs, xs, z_inv);
+    s.mul_batch(ys, ys, z_inv);
+
+    for (size_t i = 0; i < n; ++i)
+        out[i] = z_inv[i] != 0 ? Point<IntT>{xs[i], ys[i]} : Point<IntT>{};
+}
+
+/// Adds two projective points with coordinates in Montgomery form.
+///
+/// The point operations accept the ModArith<IntT> or its specialization for the modulus
+/// (e.g. SparseModArith<IntT>) as @p s.
+template <typename IntT, int A = 0, typename ModArithT = ModArith<IntT>>
+ProjPoint<IntT> add(
+    const ModArithT& s, const ProjPoint<IntT>& p, const ProjPoint<IntT>& q, const IntT& b3) noexcept
 {
     static_assert(A == 0, "point addition procedure is simplified for a = 0");
 
@@ -157,9 +239,67 @@ ProjPoint<IntT> add(const evmmax::ModArith<IntT>& s, const ProjPoint<IntT>& p,
 }
 
 
-template <typename IntT, int A = 0>
-ProjPoint<IntT> dbl(
-    const evmmax::ModArith<IntT>& s, const ProjPoint<IntT>& p, const IntT& b3) noexcept
+/// Mixed addition of a projective point and an affine point with coordinates in Montgomery form.
+///
+/// The formula is complete except the affine point @p q must not be the "infinity".
+template <typename IntT, int A = 0, typename ModArithT = ModArith<IntT>>
+ProjPoint<IntT> add(
+    const ModArithT& s, const ProjPoint<IntT>& p, const Point<IntT>& q, const IntT& b3) noexcept
+{
+    static_assert(A == 0, "point addition procedure is simplified for a = 0");
+
+    // Joost Renes and Craig Costello and Lejla Batina
+    // "Complete addition formulas for prime order elliptic curves"
+    // Cryptology ePrint Archive, Paper 2015/1060
+    // https://eprint.iacr.org/2015/1060
+    // Algorithm 8.
+
+    const auto& x1 = p.x;
+    const auto& y1 = p.y;
+    const auto& z1 = p.z;
+    const auto& x2 = q.x;
+    const auto& y2 = q.y;
+    IntT x3;
+    IntT y3;
+    IntT z3;
+    IntT t0;
+    IntT t1;
+    IntT t2;
+    IntT t3;
+    IntT t4;
+
+    t0 = s.mul(x1, x2);  // 1
+    t1 = s.mul(y1, y2);  // 2
+    t3 = s.add(x2, y2);  // 3
+    t4 = s.add(x1, y1);  // 4
+    t3 = s.mul(t3, t4);  // 5
+    t4 = s.add(t0, t1);  // 6
+    t3 = s.sub(t3, t4);  // 7
+    t4 = s.mul(y2, z1);  // 8
+    t4 = s.add(t4, y1);  // 9
+    y3 = s.mul(x2, z1);  // 10
+    y3 = s.add(y3, x1);  // 11
+    x3 = s.add(t0, t0);  // 12
+    t0 = s.add(x3, t0);  // 13
+    t2 = s.mul(b3, z1);  // 14
+    z3 = s.add(t1, t2);  // 15
+    t1 = s.sub(t1, t2);  // 16
+    y3 = s.mul(b3, y3);  // 17
+    x3 = s.mul(t4, y3);  // 18
+    t2 = s.mul(t3, t1);  // 19
+    x3 = s.sub(t2, x3);  // 20
+    y3 = s.mul(y3, t0);  // 21
+    t1 = s.mul(t1, z3);  // 22
+    y3 = s.add(t1, y3);  // 23
+    t0 = s.mul(t0, t3);  // 24
+    z3 = s.mul(z3, t4);  // 25
+    z3 = s.add(z3, t0);  // 26
+
+    return {x3, y3, z3};
+}
+
+template <typename IntT, int A = 0, typename ModArithT = ModArith<IntT>>
+ProjPoint<IntT> dbl(const ModArithT& s, const ProjPoint<IntT>& p, const IntT& b3) noexcept
 {
     static_assert(A == 0, "point doubling procedure is simplified for a = 0");
 
@@ -201,9 +341,14 @@ ProjPoint<IntT> dbl(
     return {x3, y3, z3};
 }
 
-template <typename IntT, int A = 0>
-ProjPoint<IntT> mul(const evmmax::ModArith<IntT>& s, const ProjPoint<IntT>& z, const IntT& c,
-    const IntT& b3) noexcept
+/// Computes the scalar multiplication [c]Z using the Montgomery ladder.
+///
+/// After the most significant bit of the scalar the same point operations are performed
+/// for every bit so this should be used where the execution time must not reveal the scalar.
+/// Otherwise, the wNAF-based multiplication (see to_wnaf()) is much faster.
+template <typename IntT, int A = 0, typename ModArithT = ModArith<IntT>>
+ProjPoint<IntT> mul(
+    const ModArithT& s, const ProjPoint<IntT>& z, const IntT& c, const IntT& b3) noexcept
 {
     ProjPoint<IntT> p;
     auto q = z;
@@ -231,5 +376,101 @@ ProjPoint<IntT> mul(const evmmax::ModArith<IntT>& s, const ProjPoint<IntT>& z, c
     return p;
 }
 
+/// Computes the width-W non-adjacent form (wNAF) of the scalar @p k.
+///
+/// The digits are stored from the least significant one. Each digit is either 0 or odd
+/// in the range (-2^(W-1), 2^(W-1)) and of any W consecutive digits at most one is non-zero.
+/// Therefore, only the odd multiples [1]P, [3]P, …, [2^(W-1)-1]P need to be precomputed
+/// for the scalar multiplication.
+///
+/// @return The number of digits, i.e. the position of the most significant non-zero digit + 1.
+template <int W, typename IntT, size_t N>
+size_t to_wnaf(std::array<int8_t, N>& digits, IntT k) noexcept
+{
+    static_assert(W >= 2 && W <= 8);
+    constexpr int window = 1 << W;
+
+    size_t size = 0;
+    while (k != 0)
+    {
+        assert(size < N);
+        int d = 0;
+        if ((k[0] & 1) != 0)
+        {
+            d = static_cast<int>(k[0] & (window - 1));
+            if (d >= window / 2)
+            {
+                d -= window;
+                k += static_cast<uint64_t>(-d);
+            }
+            else
+                k -= static_cast<uint64_t>(d);
+        }
+        digits[size++] = static_cast<int8_t>(d);
+        k >>= 1;
+    }
+    return size;
+}
+
+/// The scalar split into two halves by the GLV decomposition: k = k1 + k2·λ mod N.
+/// The halves are signed and stored as the absolute values and the negation flags.
+template <typename IntT>
+struct SplitScalar
+{
+    IntT k1;
+    IntT k2;
+    bool k1_neg = false;
+    bool k2_neg = false;
+};
+
+/// The parameters of the GLV scalar decomposition for the group of order N
+/// and the endomorphism φ(P) = [λ]P.
+///
+/// The {(a1, b1), (a2, b2)} is the short basis of the lattice of pairs (x, y): x + y·λ = 0 mod N
+/// with b1 < 0 (stored negated). The g1 = round(2^shift·b2 / N) and g2 = round(2^shift·(-b1) / N)
+/// approximate the rounded divisions by N.
+template <typename IntT>
+struct GLVBasis
+{
+    IntT a1;
+    IntT minus_b1;
+    IntT a2;
+    IntT b2;
+    IntT g1;
+    IntT g2;
+    unsigned shift = 0;
+};
+
+/// Splits the scalar k < N into the halves of at most half of the IntT bits.
+///
+/// See "Guide to Elliptic Curve Cryptography", Algorithm 3.74, and libsecp256k1.
+template <typename IntT>
+SplitScalar<IntT> split_scalar(const GLVBasis<IntT>& basis, const IntT& k) noexcept
+{
+    // Computes round(k·g / 2^shift).
+    const auto mul_shift = [&basis](const IntT& g, const IntT& x) noexcept {
+        const auto p = umul(x, g);
+        return static_cast<IntT>(p >> basis.shift) +
+               static_cast<IntT>((p >> (basis.shift - 1)) & 1);
+    };
+
+    const auto c1 = mul_shift(basis.g1, k);
+    const auto c2 = mul_shift(basis.g2, k);
+
+    // The results are small signed numbers so the wrapping arithmetic gives
+    // their two's complement representations.
+    auto k1 = k - c1 * basis.a1 - c2 * basis.a2;
+    auto k2 = c1 * basis.minus_b1 - c2 * basis.b2;
+
+    static constexpr auto TOP_BIT = IntT{1} << (IntT::num_bits - 1);
+    const auto k1_neg = (k1 & TOP_BIT) != 0;
+    const auto k2_neg = (k2 & TOP_BIT) != 0;
+    if (k1_neg)
+        k1 = -k1;
+    if (k2_neg)
+        k2 = -k2;
+    assert(k1 >> (IntT::num_bits / 2) == 0 && k2 >> (IntT::num_bits / 2) == 0);
+    return {k1, k2, k1_neg, k2_neg};
+}
 
 }  // namespace evmmax::ecc
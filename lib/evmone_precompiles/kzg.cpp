@@ -5,8 +5,13 @@
 #include "kzg.hpp"
 #include <blst.h>
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <mutex>
 #include <optional>
 #include <span>
+#include <string_view>
+#include <vector>
 
 namespace evmone::crypto
 {
@@ -24,18 +29,6 @@ constexpr blst_p1 G1_GENERATOR_NEGATIVE = {
         0x3cff1b76964b5317, 0x0e44d2ede9774430},
     ONE};
 
-/// The negation of the subgroup G2 generator -[1]₂ (Jacobian coordinates in Montgomery form).
-constexpr blst_p2 G2_GENERATOR_NEGATIVE{
-    {{{0xf5f28fa202940a10, 0xb3f5fb2687b4961a, 0xa1a893b53e2ae580, 0x9894999d1a3caee9,
-          0x6f67b7631863366b, 0x058191924350bcd7},
-        {0xa5a9c0759e23f606, 0xaaa0c59dbccd60c3, 0x3bb17e18e2867806, 0x1b1ab6cc8541b367,
-            0xc2b6ed0ef2158547, 0x11922a097360edf3}}},
-    {{{0x6d8bf5079fb65e61, 0xc52f05df531d63a5, 0x7f4a4d344ca692c9, 0xa887959b8577c95f,
-          0x4347fe40525c8734, 0x197d145bbaff0bb5},
-        {0x0c3e036d209afa4e, 0x0601d8f4863f9e23, 0xe0832636bacc0a84, 0xeb2def362a476f84,
-            0x64044f659f0ee1e9, 0x0ed54f48d5a1caa7}}},
-    {{ONE, {}}}};
-
 /// The point from the G2 series, index 1 of the Ethereum KZG trusted setup,
 /// i.e. [s]₂ where s is the trusted setup's secret.
 /// Affine coordinates in Montgomery form.
@@ -92,21 +85,82 @@ blst_p1 mult(const blst_p1& p, const blst_scalar& v) noexcept
     return r;
 }
 
-/// Add two points from E2 and convert the result to affine form.
-/// The conversion to affine is very costly so use only if the affine of the result is needed.
-blst_p2_affine add_or_double(const blst_p2_affine& p, const blst_p2& q) noexcept
+/// The window width for the multiplication of -[1]₁ with the precomputed table.
+constexpr size_t G1_WINDOW_WIDTH = 6;
+
+/// The number of the signed windows of the scalars < BLS_MODULUS.
+/// The top window has only 3 bits so its digit never produces a carry.
+constexpr size_t G1_NUM_WINDOWS = (BLS_MODULUS_BITS + G1_WINDOW_WIDTH - 1) / G1_WINDOW_WIDTH;
+
+/// The precomputed multiples [d·2^(W·j)](-[1]₁) for d in [1, 2^(W-1)] for every window j
+/// as affine points in Montgomery form. The table takes 129 KiB.
+///
+/// The blst fixed-base API (blst_p1s_mult_wbits) keeps a single window of multiples
+/// and still needs all 255 doublings, which is slower than the GLV multiplication
+/// of blst_p1_mult(). The table of all windows needs no doublings at all.
+struct G1Table
 {
-    blst_p2 r;
-    blst_p2_add_or_double_affine(&r, &q, &p);
-    blst_p2_affine ra;
-    blst_p2_to_affine(&ra, &r);
-    return ra;
-}
+    static constexpr size_t WINDOW_SIZE = size_t{1} << (G1_WINDOW_WIDTH - 1);
 
-blst_p2 mult(const blst_p2& p, const blst_scalar& v) noexcept
+    std::array<std::array<blst_p1_affine, WINDOW_SIZE>, G1_NUM_WINDOWS> windows;
+
+    G1Table() noexcept
+    {
+        auto base = G1_GENERATOR_NEGATIVE;
+        for (auto& window : windows)
+        {
+            std::array<blst_p1, WINDOW_SIZE> points;
+            points[0] = base;
+            for (size_t d = 1; d < WINDOW_SIZE; ++d)
+                blst_p1_add_or_double(&points[d], &points[d - 1], &base);
+            blst_p1_double(&base, &points.back());  // [2^W]base = [2·WINDOW_SIZE]base.
+
+            // Convert the window's points to affine coordinates with a single inversion.
+            std::array<const blst_p1*, WINDOW_SIZE> point_ptrs;
+            for (size_t d = 0; d < WINDOW_SIZE; ++d)
+                point_ptrs[d] = &points[d];
+            blst_p1s_to_affine(window.data(), point_ptrs.data(), WINDOW_SIZE);
+        }
+    }
+};
+
+/// Computes [k](-[1]₁) for k < BLS_MODULUS using the precomputed table of the G1 generator
+/// multiples.
+///
+/// The scalar is recoded to the signed fixed-width windows so the multiplication takes
+/// a single mixed addition per window and no doublings.
+/// The execution time depends on the scalar.
+blst_p1 mult_g1_generator_negative(const blst_scalar& k) noexcept
 {
-    blst_p2 r;
-    blst_p2_mult(&r, &p, v.b, BLS_MODULUS_BITS);
+    static constexpr auto HALF = int{1} << (G1_WINDOW_WIDTH - 1);
+    static constexpr auto MASK = (unsigned{1} << G1_WINDOW_WIDTH) - 1;
+
+    // The table is built on the first use. It is in the static storage, not on the heap.
+    static const G1Table table;
+
+    blst_p1 r{};  // Point at infinity.
+    int carry = 0;
+    for (size_t j = 0; j < G1_NUM_WINDOWS; ++j)
+    {
+        // The scalar bytes are little-endian. The window may span two bytes.
+        const auto pos = j * G1_WINDOW_WIDTH;
+        unsigned bits = k.b[pos / 8];
+        if (pos / 8 + 1 < std::size(k.b))
+            bits |= unsigned{k.b[pos / 8 + 1]} << 8;
+
+        // The digit d in [-2^(W-1), 2^(W-1)].
+        auto d = static_cast<int>((bits >> (pos % 8)) & MASK) + carry;
+        carry = d > HALF ? 1 : 0;
+        d -= carry * 2 * HALF;
+
+        if (d != 0)
+        {
+            auto e = table.windows[j][static_cast<size_t>(d < 0 ? -d : d) - 1];
+            blst_fp_cneg(&e.y, &e.y, d < 0);
+            blst_p1_add_or_double_affine(&r, &r, &e);
+        }
+    }
+    assert(carry == 0);
     return r;
 }
 
@@ -119,25 +173,58 @@ bool pairings_verify(
     blst_miller_loop(&right, &b2, &b1);
     return blst_fp12_finalverify(&left, &right);
 }
-}  // namespace
 
-bool kzg_verify_proof(const std::byte versioned_hash[VERSIONED_HASH_SIZE], const std::byte z[32],
-    const std::byte y[32], const std::byte commitment[48], const std::byte proof[48]) noexcept
+/// Checks if the versioned hash matches the commitment.
+bool check_versioned_hash(
+    const std::byte versioned_hash[VERSIONED_HASH_SIZE], const std::byte commitment[48]) noexcept
 {
     std::byte computed_versioned_hash[32];
     sha256(computed_versioned_hash, commitment, 48);
     computed_versioned_hash[0] = VERSIONED_HASH_VERSION_KZG;
-    if (!std::ranges::equal(std::span{versioned_hash, 32}, computed_versioned_hash))
-        return false;
+    return std::ranges::equal(std::span{versioned_hash, 32}, computed_versioned_hash);
+}
 
+/// Checks if the versioned hashes match the commitments of all the inputs.
+/// The commitments are hashed together with sha256_batch().
+bool check_versioned_hashes(std::span<const KzgProofInput> inputs) noexcept
+{
+    std::vector<std::span<const std::byte>> commitments;
+    commitments.reserve(inputs.size());
+    for (const auto& in : inputs)
+        commitments.emplace_back(in.commitment);
+
+    std::vector<std::array<std::byte, SHA256_HASH_SIZE>> hashes(inputs.size());
+    sha256_batch(reinterpret_cast<std::byte(*)[SHA256_HASH_SIZE]>(hashes.data()), commitments);
+
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        hashes[i][0] = VERSIONED_HASH_VERSION_KZG;
+        if (!std::ranges::equal(inputs[i].versioned_hash, hashes[i]))
+            return false;
+    }
+    return true;
+}
+
+/// The validated scalars and points of the KZG proof verification input.
+struct ValidatedInput
+{
+    blst_scalar z;
+    blst_scalar y;
+    blst_p1_affine C;
+    blst_p1_affine Pi;
+};
+
+std::optional<ValidatedInput> validate_input(const std::byte z[32], const std::byte y[32],
+    const std::byte commitment[48], const std::byte proof[48]) noexcept
+{
     // Load and validate scalars z and y.
     // TODO(C++26): The span construction can be done as std::snap(z, std::c_<32>).
     const auto zz = validate_scalar(std::span<const std::byte, 32>{z, 32});
     if (!zz)
-        return false;
+        return std::nullopt;
     const auto yy = validate_scalar(std::span<const std::byte, 32>{y, 32});
     if (!yy)
-        return false;
+        return std::nullopt;
 
     // Uncompress and validate the points C (representing the polynomial commitment)
     // and Pi (representing the proof). They both are valid to be points at infinity
@@ -145,24 +232,273 @@ bool kzg_verify_proof(const std::byte versioned_hash[VERSIONED_HASH_SIZE], const
     // see https://hackmd.io/@kevaundray/kzg-is-zero-proof-sound
     const auto C = validate_G1(std::span<const std::byte, 48>{commitment, 48});
     if (!C)
-        return false;
+        return std::nullopt;
     const auto Pi = validate_G1(std::span<const std::byte, 48>{proof, 48});
     if (!Pi)
+        return std::nullopt;
+
+    return ValidatedInput{*zz, *yy, *C, *Pi};
+}
+
+/// The key of the verified proofs cache: the versioned hash, z, y and the proof.
+///
+/// The commitment is not included because the versioned hash is checked against it
+/// before the cache lookup. The proof is included because only the valid proof
+/// must be accepted for the given commitment, z and y.
+using KzgCacheKey = std::array<std::byte, VERSIONED_HASH_SIZE + 32 + 32 + 48>;
+
+KzgCacheKey make_cache_key(const std::byte versioned_hash[VERSIONED_HASH_SIZE],
+    const std::byte z[32], const std::byte y[32], const std::byte proof[48]) noexcept
+{
+    KzgCacheKey key;
+    auto it = std::copy_n(versioned_hash, VERSIONED_HASH_SIZE, key.begin());
+    it = std::copy_n(z, 32, it);
+    it = std::copy_n(y, 32, it);
+    std::copy_n(proof, 48, it);
+    return key;
+}
+
+/// The bounded process-wide cache of the successfully verified KZG proof inputs.
+///
+/// The rollup contracts often verify the same proof multiple times in a block
+/// and the block transactions may be re-executed. When full, the least recently used
+/// entry is replaced.
+class KzgCache
+{
+    /// The maximum number of entries. Each entry takes 152 bytes.
+    static constexpr size_t CAPACITY = 256;
+
+    struct Entry
+    {
+        KzgCacheKey key;
+        uint64_t last_use = 0;
+    };
+
+    std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    uint64_t m_clock = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
+public:
+    /// Checks if the input has been verified successfully before.
+    bool find(const KzgCacheKey& key) noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        const auto it = std::ranges::find(m_entries, key, &Entry::key);
+        if (it == m_entries.end())
+        {
+            ++m_misses;
+            return false;
+        }
+        ++m_hits;
+        it->last_use = ++m_clock;
+        return true;
+    }
+
+    /// Inserts the successfully verified input.
+    void insert(const KzgCacheKey& key) noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        if (std::ranges::find(m_entries, key, &Entry::key) != m_entries.end())
+            return;  // Inserted in the meantime by another thread.
+
+        const Entry e{key, ++m_clock};
+        if (m_entries.size() < CAPACITY)
+            m_entries.push_back(e);
+        else
+            *std::ranges::min_element(m_entries, {}, &Entry::last_use) = e;
+    }
+
+    KzgCacheStats stats() noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        return {m_hits, m_misses, m_entries.size()};
+    }
+
+    void clear() noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        m_entries.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+};
+
+KzgCache& kzg_cache() noexcept
+{
+    static KzgCache cache;
+    return cache;
+}
+
+/// Computes the challenge for the batch verification as the hash of all the inputs.
+/// https://github.com/ethereum/consensus-specs/blob/dev/specs/deneb/polynomial-commitments.md#verify_kzg_proof_batch
+blst_fr compute_batch_challenge(std::span<const KzgProofInput> inputs) noexcept
+{
+    static constexpr std::string_view DOMAIN = "RCKZGBATCH___V1_";
+
+    std::vector<std::byte> data;
+    data.reserve(DOMAIN.size() + 16 + inputs.size() * (48 + 32 + 32 + 48));
+    for (const auto c : DOMAIN)
+        data.push_back(static_cast<std::byte>(c));
+    const auto append_uint64 = [&data](uint64_t v) {
+        for (int i = 7; i >= 0; --i)
+            data.push_back(static_cast<std::byte>(v >> (i * 8)));
+    };
+    append_uint64(static_cast<uint64_t>(FIELD_ELEMENTS_PER_BLOB));
+    append_uint64(inputs.size());
+    for (const auto& in : inputs)
+    {
+        data.insert(data.end(), in.commitment.begin(), in.commitment.end());
+        data.insert(data.end(), in.z.begin(), in.z.end());
+        data.insert(data.end(), in.y.begin(), in.y.end());
+        data.insert(data.end(), in.proof.begin(), in.proof.end());
+    }
+
+    std::byte hash[SHA256_HASH_SIZE];
+    sha256(hash, data.data(), data.size());
+
+    blst_scalar r_scalar;
+    blst_scalar_from_be_bytes(&r_scalar, reinterpret_cast<const uint8_t*>(hash), sizeof(hash));
+    blst_fr r;
+    blst_fr_from_scalar(&r, &r_scalar);
+    return r;
+}
+
+blst_scalar to_scalar(const blst_fr& v) noexcept
+{
+    blst_scalar s;
+    blst_scalar_from_fr(&s, &v);
+    return s;
+}
+}  // namespace
+
+bool kzg_verify_proof(const std::byte versioned_hash[VERSIONED_HASH_SIZE], const std::byte z[32],
+    const std::byte y[32], const std::byte commitment[48], const std::byte proof[48]) noexcept
+{
+    if (!check_versioned_hash(versioned_hash, commitment))
+        return false;
+
+    auto& cache = kzg_cache();
+    const auto key = make_cache_key(versioned_hash, z, y, proof);
+    if (cache.find(key))
+        return true;
+
+    const auto input = validate_input(z, y, commitment, proof);
+    if (!input)
         return false;
 
+    // The check e(C - [y]₁, [1]₂) = e(Pi, [s - z]₂) is equivalent to
+    // e(C - [y]₁ + [z]Pi, [1]₂) = e(Pi, [s]₂). This replaces the G2 generator multiplication [z]₂
+    // with the cheaper G1 multiplication [z]Pi.
+
     // Compute -Y as [y * -1]₁.
-    const auto neg_Y = mult(G1_GENERATOR_NEGATIVE, *yy);
+    const auto neg_Y = mult_g1_generator_negative(input->y);
 
-    // Compute C - Y. It can happen that C == -Y so doubling may be needed.
-    const auto C_sub_Y = add_or_double(*C, neg_Y);
+    // Compute [z]Pi.
+    blst_p1 Pi;
+    blst_p1_from_affine(&Pi, &input->Pi);
+    const auto z_Pi = mult(Pi, input->z);
 
-    // Compute -Z as [z * -1]₂.
-    const auto neg_Z = mult(G2_GENERATOR_NEGATIVE, *zz);
+    // Compute C - Y + [z]Pi. It can happen that the points are equal so doubling may be needed.
+    blst_p1 neg_Y_add_z_Pi;
+    blst_p1_add_or_double(&neg_Y_add_z_Pi, &neg_Y, &z_Pi);
+    const auto lhs = add_or_double(input->C, neg_Y_add_z_Pi);
 
-    // Compute X - Z which is [s - z]₂.
-    const auto X_sub_Z = add_or_double(KZG_SETUP_G2_1, neg_Z);
+    // e(C - [y]₁ + [z]Pi, [1]₂) =? e(Pi, [s]₂)
+    if (!pairings_verify(lhs, input->Pi, KZG_SETUP_G2_1))
+        return false;
 
-    // e(C - [y]₁, [1]₂) =? e(Pi, [s - z]₂)
-    return pairings_verify(C_sub_Y, *Pi, X_sub_Z);
+    cache.insert(key);
+    return true;
+}
+
+bool kzg_verify_proof_batch(std::span<const KzgProofInput> inputs) noexcept
+{
+    if (inputs.size() == 1)
+    {
+        const auto& in = inputs[0];
+        return kzg_verify_proof(in.versioned_hash.data(), in.z.data(), in.y.data(),
+            in.commitment.data(), in.proof.data());
+    }
+
+    // The check e(Cᵢ - [yᵢ]₁, [1]₂) = e(Piᵢ, [s - zᵢ]₂) is equivalent to
+    // e(Cᵢ - [yᵢ]₁ + [zᵢ]Piᵢ, [1]₂) = e(Piᵢ, [s]₂). These are combined with the powers
+    // of the random challenge r into the single check
+    // e(∑rⁱ(Cᵢ + [zᵢ]Piᵢ) - [∑rⁱyᵢ]₁, [1]₂) = e(∑rⁱPiᵢ, [s]₂).
+    if (!check_versioned_hashes(inputs))
+        return false;
+
+    const auto r = compute_batch_challenge(inputs);
+
+    blst_fr r_power;
+    {
+        blst_scalar one{};
+        one.b[0] = 1;
+        blst_fr_from_scalar(&r_power, &one);
+    }
+
+    blst_p1 lhs{};              // Point at infinity.
+    blst_p1 proof_lincomb{};    // Point at infinity.
+    blst_fr y_lincomb{};        // Zero.
+    for (const auto& in : inputs)
+    {
+        const auto input =
+            validate_input(in.z.data(), in.y.data(), in.commitment.data(), in.proof.data());
+        if (!input)
+            return false;
+
+        blst_fr z;
+        blst_fr_from_scalar(&z, &input->z);
+        blst_fr y;
+        blst_fr_from_scalar(&y, &input->y);
+
+        blst_fr rz;
+        blst_fr_mul(&rz, &r_power, &z);
+        blst_fr ry;
+        blst_fr_mul(&ry, &r_power, &y);
+        blst_fr_add(&y_lincomb, &y_lincomb, &ry);
+
+        blst_p1 C;
+        blst_p1_from_affine(&C, &input->C);
+        blst_p1 Pi;
+        blst_p1_from_affine(&Pi, &input->Pi);
+
+        const auto r_scalar = to_scalar(r_power);
+        const auto r_Pi = mult(Pi, r_scalar);
+        const auto r_C = mult(C, r_scalar);
+        const auto rz_Pi = mult(Pi, to_scalar(rz));
+        blst_p1_add_or_double(&proof_lincomb, &proof_lincomb, &r_Pi);
+        blst_p1_add_or_double(&lhs, &lhs, &r_C);
+        blst_p1_add_or_double(&lhs, &lhs, &rz_Pi);
+
+        blst_fr_mul(&r_power, &r_power, &r);
+    }
+
+    const auto neg_Y = mult_g1_generator_negative(to_scalar(y_lincomb));
+    blst_p1_add_or_double(&lhs, &lhs, &neg_Y);
+
+    blst_p1_affine lhs_affine;
+    blst_p1_to_affine(&lhs_affine, &lhs);
+    blst_p1_affine proof_lincomb_affine;
+    blst_p1_to_affine(&proof_lincomb_affine, &proof_lincomb);
+    if (!pairings_verify(lhs_affine, proof_lincomb_affine, KZG_SETUP_G2_1))
+        return false;
+
+    auto& cache = kzg_cache();
+    for (const auto& in : inputs)
+        cache.insert(make_cache_key(in.versioned_hash.data(), in.z.data(), in.y.data(),
+            in.proof.data()));
+    return true;
+}
+
+KzgCacheStats kzg_cache_stats() noexcept
+{
+    return kzg_cache().stats();
+}
+
+void kzg_cache_clear() noexcept
+{
+    kzg_cache().clear();
 }
 }  // namespace evmone::crypto
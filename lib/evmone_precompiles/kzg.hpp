@@ -5,6 +5,8 @@
 #pragma once
 #include "sha256.hpp"
 #include <intx/intx.hpp>
+#include <array>
+#include <span>
 
 namespace evmone::crypto
 {
@@ -27,6 +29,53 @@ constexpr auto BLS_MODULUS =
 constexpr size_t BLS_MODULUS_BITS = 255;
 static_assert((BLS_MODULUS >> BLS_MODULUS_BITS) == 0);
 
+/// Verifies the KZG proof that the polynomial of the commitment evaluates to y at z
+/// (the point evaluation precompile, EIP-4844).
+///
+/// The successfully verified inputs are kept in the bounded process-wide cache
+/// (see kzg_cache_stats()) so verifying the same input again does not repeat the pairing check.
 bool kzg_verify_proof(const std::byte versioned_hash[VERSIONED_HASH_SIZE], const std::byte z[32],
     const std::byte y[32], const std::byte commitment[48], const std::byte proof[48]) noexcept;
+
+/// The input of the KZG proof verification. The layout matches the point evaluation
+/// precompile input.
+struct KzgProofInput
+{
+    std::array<std::byte, VERSIONED_HASH_SIZE> versioned_hash;
+    std::array<std::byte, 32> z;
+    std::array<std::byte, 32> y;
+    std::array<std::byte, 48> commitment;
+    std::array<std::byte, 48> proof;
+};
+static_assert(sizeof(KzgProofInput) == 192);
+
+/// Verifies multiple KZG proofs at once.
+///
+/// The proofs are combined with the powers of the random challenge (derived by hashing
+/// all inputs as in the verify_kzg_proof_batch() of the consensus specs)
+/// into a single pairing check. Returns true if all proofs are valid (with overwhelming
+/// probability). This is meant for the block-level pre-verification: on success
+/// all the inputs are inserted to the cache used by kzg_verify_proof().
+bool kzg_verify_proof_batch(std::span<const KzgProofInput> inputs) noexcept;
+
+/// The statistics of the process-wide cache of the verified KZG proofs.
+struct KzgCacheStats
+{
+    uint64_t hits = 0;    ///< The number of lookups of the cached inputs.
+    uint64_t misses = 0;  ///< The number of lookups of the inputs not in the cache.
+    size_t size = 0;      ///< The current number of the cached inputs.
+
+    /// The fraction of lookups served by the cache.
+    [[nodiscard]] double hit_rate() const noexcept
+    {
+        const auto lookups = hits + misses;
+        return lookups != 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+/// Returns the statistics of the verified KZG proofs cache.
+KzgCacheStats kzg_cache_stats() noexcept;
+
+/// Removes all the entries from the verified KZG proofs cache and resets the statistics.
+void kzg_cache_clear() noexcept;
 }  // namespace evmone::crypto
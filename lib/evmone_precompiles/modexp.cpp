@@ -0,0 +1,595 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "modexp.hpp"
+#include <evmmax/evmmax.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <vector>
+
+namespace evmone::crypto
+{
+namespace
+{
+/// The variable-width unsigned integer: little-endian 64-bit words.
+using Words = std::vector<uint64_t>;
+
+/// Loads the big-endian bytes as the words. The size of the result is the minimal number
+/// of words fitting all the bytes (leading zero bytes included).
+Words load_words(std::span<const uint8_t> bytes)
+{
+    Words r((bytes.size() + 7) / 8);
+    for (size_t i = 0; i < bytes.size(); ++i)
+        r[i / 8] |= uint64_t{bytes[bytes.size() - 1 - i]} << (i % 8 * 8);
+    return r;
+}
+
+/// Stores the words as big-endian bytes. The words not fitting the output must be zero.
+void store_words(std::span<uint8_t> out, const Words& x) noexcept
+{
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        const auto w = i / 8 < x.size() ? x[i / 8] : 0;
+        out[out.size() - 1 - i] = static_cast<uint8_t>(w >> (i % 8 * 8));
+    }
+    assert([&] {
+        for (auto i = out.size(); i < x.size() * 8; ++i)
+        {
+            if (static_cast<uint8_t>(x[i / 8] >> (i % 8 * 8)) != 0)
+                return false;
+        }
+        return true;
+    }());
+}
+
+/// Removes the high zero words.
+void trim(Words& x) noexcept
+{
+    while (!x.empty() && x.back() == 0)
+        x.pop_back();
+}
+
+/// Computes the lowest n words of the product x⋅y (schoolbook multiplication).
+Words mul_lo(const Words& x, const Words& y, size_t n)
+{
+    Words r(n);
+    for (size_t i = 0; i < std::min(x.size(), n); ++i)
+    {
+        uint64_t c = 0;
+        const auto m = std::min(y.size(), n - i);
+        for (size_t j = 0; j < m; ++j)
+        {
+            const auto p = intx::umul(x[i], y[j]) + r[i + j] + c;
+            r[i + j] = p[0];
+            c = p[1];
+        }
+        if (i + m < n)
+            r[i + m] = c;
+    }
+    return r;
+}
+
+/// Computes the remainder u % v with the Knuth's long division (TAOCP 4.3.1, Algorithm D).
+/// The v must have at least 2 words and the non-zero top word. The u must not be shorter than v.
+Words rem(Words u, Words v)
+{
+    const auto n = v.size();
+    assert(n >= 2 && v.back() != 0 && u.size() >= n);
+
+    // Normalize the operands so that the top bit of the divisor is set.
+    const auto shift = std::countl_zero(v.back());
+    const auto shl = [shift](Words& x) noexcept {
+        if (shift == 0)
+            return;
+        for (auto i = x.size() - 1; i != 0; --i)
+            x[i] = (x[i] << shift) | (x[i - 1] >> (64 - shift));
+        x[0] <<= shift;
+    };
+    u.push_back(0);
+    shl(u);
+    shl(v);
+
+    const auto v_top = v[n - 1];
+    for (auto j = u.size() - n; j-- != 0;)
+    {
+        // Estimate the quotient digit from the top words. The estimate is at most 2 too big.
+        auto [q_hat, r_hat] =
+            intx::udivrem(intx::uint128{u[j + n - 1], u[j + n]}, intx::uint128{v_top});
+        while (q_hat[1] != 0 ||
+               intx::umul(q_hat[0], v[n - 2]) > intx::uint128{u[j + n - 2], r_hat[0]})
+        {
+            q_hat -= 1;
+            r_hat += v_top;
+            if (r_hat[1] != 0)
+                break;
+        }
+
+        // Subtract q̂⋅v from the current part of u.
+        uint64_t mul_carry = 0;
+        bool borrow = false;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto p = intx::umul(q_hat[0], v[i]) + mul_carry;
+            mul_carry = p[1];
+            const auto d = intx::subc(u[i + j], p[0], borrow);
+            u[i + j] = d.value;
+            borrow = d.carry;
+        }
+        const auto d = intx::subc(u[j + n], mul_carry, borrow);
+        u[j + n] = d.value;
+
+        // The estimate was 1 too big: add back the divisor.
+        if (d.carry)
+        {
+            bool carry = false;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto a = intx::addc(u[i + j], v[i], carry);
+                u[i + j] = a.value;
+                carry = a.carry;
+            }
+            u[j + n] += uint64_t{carry};
+        }
+    }
+
+    // Denormalize the remainder.
+    u.resize(n);
+    if (shift != 0)
+    {
+        for (size_t i = 0; i + 1 < n; ++i)
+            u[i] = (u[i] >> shift) | (u[i + 1] << (64 - shift));
+        u[n - 1] >>= shift;
+    }
+    return u;
+}
+
+/// Computes the inverse of the odd number x modulo 2⁶⁴.
+constexpr uint64_t inv_mod64(uint64_t x) noexcept
+{
+    assert(x % 2 == 1);
+    // Newton's iteration y ← y⋅(2 - x⋅y) doubles the number of correct low bits.
+    // The initial y = x is correct for 3 bits because x⋅x ≡ 1 (mod 8) for odd x.
+    uint64_t y = x;
+    for (int i = 0; i < 5; ++i)
+        y *= 2 - x * y;
+    return y;
+}
+
+/// The Montgomery arithmetic of the fixed width (evmmax::ModArith) with the interface
+/// of the generic exponentiation.
+template <typename UintT>
+class FixedModArith : public evmmax::ModArith<UintT>
+{
+public:
+    using value_type = UintT;
+
+    explicit FixedModArith(const Words& mod) noexcept
+      : evmmax::ModArith<UintT>{[&mod] {
+            UintT m{};
+            std::copy(mod.begin(), mod.end(), &m[0]);
+            return m;
+        }()}
+    {
+        assert(mod.size() <= UintT::num_words);
+    }
+
+    /// The width of the arithmetic in bytes. The values (not in Montgomery form) of this width
+    /// are accepted by to_mont().
+    static constexpr size_t num_bytes() noexcept { return sizeof(UintT); }
+
+    /// Loads the big-endian bytes (at most num_bytes()).
+    static UintT load(std::span<const uint8_t> bytes) noexcept
+    {
+        uint8_t buffer[sizeof(UintT)]{};
+        std::ranges::copy(bytes, std::end(buffer) - bytes.size());
+        return intx::be::unsafe::load<UintT>(buffer);
+    }
+
+    using evmmax::ModArith<UintT>::mul;
+    using evmmax::ModArith<UintT>::add;
+
+    void mul(UintT& r, const UintT& x, const UintT& y) const noexcept { r = mul(x, y); }
+
+    void add(UintT& r, const UintT& x, const UintT& y) const noexcept { r = add(x, y); }
+
+    UintT one() const noexcept { return this->to_mont(UintT{1}); }
+
+    static Words to_words(const UintT& x) { return Words(&x[0], &x[0] + UintT::num_words); }
+};
+
+/// The Montgomery arithmetic of any width for the moduli wider than the widest FixedModArith.
+///
+/// The multiplication is the variable-width variant of the CIOS method
+/// used by evmmax::ModArith::mul(). The hot operations do not allocate:
+/// they use the preallocated scratch space and write the results to the provided values.
+class VarModArith
+{
+    Words m_mod;
+    uint64_t m_mod_inv;  ///< N' such that mod⋅N' ≡ -1 (mod 2⁶⁴).
+    mutable Words m_t;   ///< The scratch space of n + 2 words.
+    Words m_r_squared;   ///< R² % mod.
+
+    /// Writes to r the value t + carry⋅R reduced by subtracting the modulus once if needed.
+    /// The value must be less than 2⋅mod. The r must not alias the t.
+    void reduce_once(Words& r, const uint64_t* t, bool carry) const noexcept
+    {
+        const auto n = m_mod.size();
+        bool borrow = false;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto s = intx::subc(t[i], m_mod[i], borrow);
+            r[i] = s.value;
+            borrow = s.carry;
+        }
+        if (!carry && borrow)
+            std::copy_n(t, n, r.begin());
+    }
+
+    /// Computes R² % mod where R = 2⁶⁴ⁿ with the single long division.
+    Words compute_r_squared() const
+    {
+        const auto n = m_mod.size();
+        Words r2(2 * n + 1);
+        r2.back() = 1;
+        return rem(std::move(r2), m_mod);
+    }
+
+public:
+    using value_type = Words;
+
+    explicit VarModArith(Words mod)
+      : m_mod{std::move(mod)},
+        m_mod_inv{0 - inv_mod64(m_mod[0])},
+        m_t(m_mod.size() + 2),
+        m_r_squared{compute_r_squared()}
+    {}
+
+    size_t num_bytes() const noexcept { return m_mod.size() * sizeof(uint64_t); }
+
+    Words load(std::span<const uint8_t> bytes) const
+    {
+        assert(bytes.size() <= num_bytes());
+        auto x = load_words(bytes);
+        x.resize(m_mod.size());
+        return x;
+    }
+
+    /// Computes r = x⋅y⋅R⁻¹ % mod. The r may alias the x or y.
+    void mul(Words& r, const Words& x, const Words& y) const
+    {
+        const auto n = m_mod.size();
+        auto& t = m_t;
+        std::fill(t.begin(), t.end(), uint64_t{0});
+        for (size_t i = 0; i != n; ++i)
+        {
+            uint64_t c = 0;
+            for (size_t j = 0; j != n; ++j)
+            {
+                const auto p = intx::umul(x[j], y[i]) + t[j] + c;
+                t[j] = p[0];
+                c = p[1];
+            }
+            auto s = intx::addc(t[n], c);
+            t[n] = s.value;
+            t[n + 1] = s.carry;
+
+            const auto m = t[0] * m_mod_inv;
+            c = (intx::umul(m, m_mod[0]) + t[0])[1];
+            for (size_t j = 1; j != n; ++j)
+            {
+                const auto p = intx::umul(m, m_mod[j]) + t[j] + c;
+                t[j - 1] = p[0];
+                c = p[1];
+            }
+            s = intx::addc(t[n], c);
+            t[n - 1] = s.value;
+            t[n] = t[n + 1] + s.carry;
+        }
+        r.resize(n);
+        reduce_once(r, t.data(), t[n] != 0);
+    }
+
+    Words mul(const Words& x, const Words& y) const
+    {
+        Words r;
+        mul(r, x, y);
+        return r;
+    }
+
+    /// Computes r = x + y % mod. The r may alias the x or y.
+    void add(Words& r, const Words& x, const Words& y) const
+    {
+        const auto n = m_mod.size();
+        bool carry = false;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto a = intx::addc(x[i], y[i], carry);
+            m_t[i] = a.value;
+            carry = a.carry;
+        }
+        r.resize(n);
+        reduce_once(r, m_t.data(), carry);
+    }
+
+    Words to_mont(const Words& x) const { return mul(x, m_r_squared); }
+
+    Words from_mont(const Words& x) const
+    {
+        Words one(m_mod.size());
+        one[0] = 1;
+        return mul(x, one);
+    }
+
+    Words one() const
+    {
+        Words r(m_mod.size());
+        r[0] = 1;
+        return to_mont(r);
+    }
+
+    static Words to_words(Words x) noexcept { return x; }
+};
+
+/// The arithmetic modulo 2ᵏ. The values are kept in n = ⌈k/64⌉ words and the "Montgomery form"
+/// is the identity.
+class Pow2Arith
+{
+    size_t m_num_words;
+    uint64_t m_top_mask;
+
+    /// Truncates the value to k bits.
+    Words reduce(Words x) const
+    {
+        x.resize(m_num_words);
+        x.back() &= m_top_mask;
+        return x;
+    }
+
+public:
+    using value_type = Words;
+
+    explicit Pow2Arith(size_t k) noexcept
+      : m_num_words{(k + 63) / 64}, m_top_mask{~uint64_t{0} >> ((64 - k % 64) % 64)}
+    {
+        assert(k != 0);
+    }
+
+    /// Loads the big-endian bytes reduced modulo 2ᵏ.
+    Words load(std::span<const uint8_t> bytes) const
+    {
+        const auto n = std::min(bytes.size(), m_num_words * sizeof(uint64_t));
+        return reduce(load_words(bytes.last(n)));
+    }
+
+    Words mul(const Words& x, const Words& y) const { return reduce(mul_lo(x, y, m_num_words)); }
+
+    void mul(Words& r, const Words& x, const Words& y) const { r = mul(x, y); }
+
+    Words sub(const Words& x, const Words& y) const
+    {
+        Words d(m_num_words);
+        bool borrow = false;
+        for (size_t i = 0; i < m_num_words; ++i)
+        {
+            const auto s = intx::subc(x[i], i < y.size() ? y[i] : 0, borrow);
+            d[i] = s.value;
+            borrow = s.carry;
+        }
+        return reduce(std::move(d));
+    }
+
+    /// Computes the inverse of the odd x modulo 2ᵏ.
+    Words inv(const Words& x) const
+    {
+        // Newton's iteration y ← y⋅(2 - x⋅y) starting from the inverse modulo 2⁶⁴.
+        Words y(m_num_words);
+        y[0] = inv_mod64(x[0]);
+        y = reduce(std::move(y));
+        Words two(m_num_words);
+        two[0] = 2;
+        for (size_t bits = 64; bits < m_num_words * 64; bits *= 2)
+            y = mul(y, sub(two, mul(x, y)));
+        return y;
+    }
+
+    Words one() const
+    {
+        Words r(m_num_words);
+        r[0] = 1;
+        return r;
+    }
+
+    static Words to_mont(Words x) noexcept { return x; }
+    static Words from_mont(Words x) noexcept { return x; }
+};
+
+/// The exponent: big-endian bytes without leading zero bytes.
+class Exponent
+{
+    std::span<const uint8_t> m_bytes;
+
+public:
+    explicit Exponent(std::span<const uint8_t> bytes) noexcept
+      : m_bytes{bytes.subspan(static_cast<size_t>(
+            std::ranges::find_if(bytes, [](uint8_t b) { return b != 0; }) - bytes.begin()))}
+    {}
+
+    [[nodiscard]] size_t bit_width() const noexcept
+    {
+        return m_bytes.empty() ? 0 : (m_bytes.size() - 1) * 8 + std::bit_width(m_bytes[0]);
+    }
+
+    [[nodiscard]] unsigned bit(size_t i) const noexcept
+    {
+        return (m_bytes[m_bytes.size() - 1 - i / 8] >> (i % 8)) & 1;
+    }
+};
+
+/// The maximum sliding window size.
+constexpr unsigned MAX_WINDOW_SIZE = 6;
+
+/// Returns the sliding window size for the exponent of the given bit width.
+/// The thresholds minimize the number of multiplications including the precomputation.
+constexpr unsigned window_size(size_t exp_bit_width) noexcept
+{
+    if (exp_bit_width > 671)
+        return MAX_WINDOW_SIZE;
+    if (exp_bit_width > 239)
+        return 5;
+    if (exp_bit_width > 79)
+        return 4;
+    if (exp_bit_width > 23)
+        return 3;
+    return 1;
+}
+
+/// Computes x^e using the left-to-right sliding window exponentiation.
+/// The x and the result are in the Arith's Montgomery form.
+template <typename Arith>
+typename Arith::value_type pow(
+    const Arith& arith, const typename Arith::value_type& x, const Exponent& e)
+{
+    const auto num_bits = e.bit_width();
+    if (num_bits == 0)
+        return arith.one();
+
+    // The odd powers of x: x, x³, x⁵, ..., x^(2ʷ-1).
+    const auto w = window_size(num_bits);
+    const auto num_odd_powers = size_t{1} << (w - 1);
+    std::array<typename Arith::value_type, size_t{1} << (MAX_WINDOW_SIZE - 1)> odd_powers;
+    odd_powers[0] = x;
+    if (num_odd_powers > 1)
+    {
+        const auto x2 = arith.mul(x, x);
+        for (size_t i = 1; i < num_odd_powers; ++i)
+            arith.mul(odd_powers[i], odd_powers[i - 1], x2);
+    }
+
+    // The first window starts at the top bit (always 1) so the result is initialized
+    // with the window's power instead of squaring and multiplying the one.
+    typename Arith::value_type r;
+    bool first = true;
+    for (auto i = num_bits; i != 0;)  // i is the number of remaining exponent bits.
+    {
+        if (e.bit(i - 1) == 0)
+        {
+            arith.mul(r, r, r);
+            --i;
+            continue;
+        }
+
+        // The window of exponent bits [i-1, l] ending with the bit 1.
+        auto l = i > w ? i - w : 0;
+        while (e.bit(l) == 0)
+            ++l;
+        size_t v = 0;
+        for (auto j = i; j != l; --j)
+            v = (v << 1) | e.bit(j - 1);
+
+        if (first)
+            r = odd_powers[v >> 1];
+        else
+        {
+            for (auto j = l; j != i; ++j)
+                arith.mul(r, r, r);
+            arith.mul(r, r, odd_powers[v >> 1]);
+        }
+        first = false;
+        i = l;
+    }
+    return r;
+}
+
+/// Computes base^e % mod for the odd mod > 1 in the Montgomery arithmetic.
+template <typename Arith>
+Words mont_modexp(const Arith& arith, std::span<const uint8_t> base, const Exponent& e)
+{
+    // Convert the base to the Montgomery form. The base can be wider than the arithmetic
+    // so the Horner's scheme x ← x⋅R + chunk is applied to the chunks of the width R.
+    // In the Montgomery form this is xR ← to_mont(xR) + to_mont(chunk).
+    const auto chunk_size = arith.num_bytes();
+    auto pos = base.size() % chunk_size;
+    if (pos == 0)
+        pos = std::min(base.size(), chunk_size);
+    auto x = arith.to_mont(arith.load(base.first(pos)));
+    for (; pos != base.size(); pos += chunk_size)
+        arith.add(x, arith.to_mont(x), arith.to_mont(arith.load(base.subspan(pos, chunk_size))));
+
+    return arith.to_words(arith.from_mont(pow(arith, x, e)));
+}
+
+/// Computes base^e % mod for the odd mod > 1.
+/// Selects the narrowest fixed-width arithmetic fitting the modulus
+/// or the variable-width arithmetic for the very wide moduli.
+Words odd_modexp(const Words& mod, std::span<const uint8_t> base, const Exponent& e)
+{
+    const auto n = mod.size();
+    if (n <= 4)
+        return mont_modexp(FixedModArith<intx::uint256>{mod}, base, e);
+    if (n <= 8)
+        return mont_modexp(FixedModArith<intx::uint512>{mod}, base, e);
+    if (n <= 16)
+        return mont_modexp(FixedModArith<intx::uint<1024>>{mod}, base, e);
+    if (n <= 32)
+        return mont_modexp(FixedModArith<intx::uint<2048>>{mod}, base, e);
+    if (n <= 64)
+        return mont_modexp(FixedModArith<intx::uint<4096>>{mod}, base, e);
+    return mont_modexp(VarModArith{mod}, base, e);
+}
+}  // namespace
+
+void modexp(uint8_t* output, std::span<const uint8_t> base, std::span<const uint8_t> exp,
+    std::span<const uint8_t> mod)
+{
+    const std::span out{output, mod.size()};
+
+    auto m = load_words(mod);
+    trim(m);
+    if (m.empty() || (m.size() == 1 && m[0] == 1))
+    {
+        std::ranges::fill(out, uint8_t{0});
+        return;
+    }
+
+    const Exponent e{exp};
+
+    // Split the modulus m = m_odd⋅2ᵏ.
+    const auto tz_words = static_cast<size_t>(
+        std::ranges::find_if(m, [](uint64_t w) { return w != 0; }) - m.begin());
+    const auto k = tz_words * 64 + static_cast<size_t>(std::countr_zero(m[tz_words]));
+    if (k == 0)
+        return store_words(out, odd_modexp(m, base, e));
+
+    const Pow2Arith pow2{k};
+    const auto r_pow2 = pow(pow2, pow2.load(base), e);
+
+    Words m_odd(m.begin() + static_cast<ptrdiff_t>(tz_words), m.end());
+    if (const auto shift = k % 64; shift != 0)
+    {
+        for (size_t i = 0; i < m_odd.size(); ++i)
+            m_odd[i] = (m_odd[i] >> shift) |
+                       (i + 1 < m_odd.size() ? m_odd[i + 1] << (64 - shift) : 0);
+    }
+    trim(m_odd);
+    if (m_odd.size() == 1 && m_odd[0] == 1)
+        return store_words(out, r_pow2);
+
+    // Combine the results by the Chinese remainder theorem (Garner's formula):
+    // r = r_odd + m_odd⋅((r_pow2 - r_odd)⋅m_odd⁻¹ mod 2ᵏ).
+    const auto r_odd = odd_modexp(m_odd, base, e);
+    const auto y = pow2.mul(pow2.sub(r_pow2, r_odd), pow2.inv(m_odd));
+    auto r = mul_lo(m_odd, y, m_odd.size() + y.size());
+    bool carry = false;
+    for (size_t i = 0; i < r.size(); ++i)
+    {
+        const auto s = intx::addc(r[i], i < r_odd.size() ? r_odd[i] : 0, carry);
+        r[i] = s.value;
+        carry = s.carry;
+    }
+    assert(!carry);
+    store_words(out, r);
+}
+}  // namespace evmone::crypto
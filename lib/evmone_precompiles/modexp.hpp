@@ -0,0 +1,24 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace evmone::crypto
+{
+/// Computes the modular exponentiation base^exp % mod (the MODEXP precompile, EIP-198).
+///
+/// All numbers are big-endian and may have any length.
+/// The working memory proportional to the modulus size is allocated on the heap.
+///
+/// @param[out] output  The result is written to the provided memory of the size of the @p mod.
+///                     The result for the modulus 0 is 0.
+/// @param      base    The base.
+/// @param      exp     The exponent.
+/// @param      mod     The modulus.
+/// @throws std::bad_alloc  If the working memory cannot be allocated.
+void modexp(uint8_t* output, std::span<const uint8_t> base, std::span<const uint8_t> exp,
+    std::span<const uint8_t> mod);
+}  // namespace evmone::crypto
@@ -15,7 +15,7 @@ using namespace intx;
 struct BaseFieldConfig
 {
     using ValueT = uint256;
-    static constexpr auto MOD_ARITH = ModArith{FieldPrime};
+    static constexpr auto MOD_ARITH = SparseModArith{FieldPrime};
     static constexpr uint256 ONE = MOD_ARITH.to_mont(1);
 };
 using Fq = ecc::BaseFieldElem<BaseFieldConfig>;
@@ -62,10 +62,16 @@ using Fq12 = ecc::ExtFieldElem<Fq12Config>;
 /// Multiplies two Fq^2 field elements
 constexpr Fq2 multiply(const Fq2& a, const Fq2& b)
 {
-    return Fq2({
-        a.coeffs[0] * b.coeffs[0] - a.coeffs[1] * b.coeffs[1],
-        a.coeffs[1] * b.coeffs[0] + a.coeffs[0] * b.coeffs[1],
-    });
+    // Karatsuba multiplication: 3 base field multiplications instead of 4.
+    // The sums (a0 + a1) and (b0 + b1) are lazily reduced.
+    const auto& a0 = a.coeffs[0];
+    const auto& a1 = a.coeffs[1];
+    const auto& b0 = b.coeffs[0];
+    const auto& b1 = b.coeffs[1];
+
+    const auto t0 = a0 * b0;
+    const auto t1 = a1 * b1;
+    return Fq2({t0 - t1, mul_sums(a0, a1, b0, b1) - t0 - t1});
 }
 
 /// Multiplies two Fq^6 field elements
@@ -113,7 +119,7 @@ constexpr Fq12 multiply(const Fq12& a, const Fq12& b)
 /// Inverses the base field element
 inline Fq inverse(const Fq& x)
 {
-    return Fq(field_inv(BaseFieldConfig::MOD_ARITH, x.value()));
+    return Fq(BaseFieldConfig::MOD_ARITH.inv(x.value()));
 }
 
 /// Inverses the Fq^2 field element
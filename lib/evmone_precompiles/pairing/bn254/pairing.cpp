@@ -5,6 +5,13 @@
 #include "../../bn254.hpp"
 #include "fields.hpp"
 #include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
 #include <vector>
 
 namespace evmmax::bn254
@@ -44,32 +51,38 @@ constexpr void multiply_by_lin_func_value(
 inline constexpr auto ATE_LOOP_COUNT_NAF = 0x1120804220120081204008212022011_u128;
 inline constexpr int LOG_ATE_LOOP_COUNT = 63;
 
-/// Miller loop according to https://eprint.iacr.org/2010/354.pdf Algorithm 1.
-Fq12 miller_loop(const ecc::Point<Fq2>& Q, const ecc::Point<Fq>& P) noexcept
+/// The number of line functions in the Miller loop: one per doubling, one per non-zero
+/// NAF digit of the loop count and the two final additions.
+inline constexpr size_t NUM_LINES = [] {
+    size_t n = LOG_ATE_LOOP_COUNT + 1 + 2;
+    for (auto naf = ATE_LOOP_COUNT_NAF; naf != 0; naf >>= 2)
+        n += (naf & 3) != 0;
+    return n;
+}();
+
+/// The coefficients of all the line functions of the Miller loop for a G2 point Q.
+/// They only depend on Q so they are computed once and then evaluated at the G1 points.
+using G2Lines = std::array<std::array<Fq2, 3>, NUM_LINES>;
+
+/// Computes the line functions of the Miller loop (https://eprint.iacr.org/2010/354.pdf
+/// Algorithm 1) for the point Q.
+G2Lines prepare_lines(const ecc::Point<Fq2>& Q) noexcept
 {
+    G2Lines lines;
+    auto line = lines.begin();
+
     auto T = ecc::JacPoint<Fq2>::from(Q);
-    auto nQ = -Q;
-    auto f = Fq12::one();
-    std::array<Fq2, 3> t;
+    const auto nQ = -Q;
     auto naf = ATE_LOOP_COUNT_NAF;
-    const auto ny = -P.y;
 
     for (int i = 0; i <= LOG_ATE_LOOP_COUNT; ++i)
     {
-        T = lin_func_and_dbl(T, t);
-        f = square(f);
-        multiply_by_lin_func_value(f, t, P.x, ny);
+        T = lin_func_and_dbl(T, *line++);
 
         if (naf & 1)
-        {
-            T = lin_func_and_add(T, Q, t);
-            multiply_by_lin_func_value(f, t, P.x, P.y);
-        }
+            T = lin_func_and_add(T, Q, *line++);
         else if (naf & 2)
-        {
-            T = lin_func_and_add(T, nQ, t);
-            multiply_by_lin_func_value(f, t, P.x, P.y);
-        }
+            T = lin_func_and_add(T, nQ, *line++);
         naf >>= 2;
     }
 
@@ -81,15 +94,143 @@ Fq12 miller_loop(const ecc::Point<Fq2>& Q, const ecc::Point<Fq>& P) noexcept
     // negation according to miller loop spec.
     const auto nQ2 = -endomorphism<2>(Q);
 
-    T = lin_func_and_add(T, Q1, t);
-    multiply_by_lin_func_value(f, t, P.x, P.y);
+    T = lin_func_and_add(T, Q1, *line++);
+    lin_func(T, nQ2, *line++);
+
+    assert(line == lines.end());
+    return lines;
+}
+
+/// The Miller loop input: the G1 point P and the line functions of the G2 point Q.
+struct MillerLoopInput
+{
+    ecc::Point<Fq> P;
+    const G2Lines* lines = nullptr;
+};
+
+/// Computes the product of the Miller loops for all the inputs.
+///
+/// The loops are run simultaneously so the squaring of the Fq12 accumulator
+/// is shared by all the pairs.
+Fq12 multi_miller_loop(std::span<const MillerLoopInput> inputs) noexcept
+{
+    auto f = Fq12::one();
+    size_t line = 0;
+    auto naf = ATE_LOOP_COUNT_NAF;
+
+    for (int i = 0; i <= LOG_ATE_LOOP_COUNT; ++i)
+    {
+        f = square(f);
+        for (const auto& [P, lines] : inputs)
+            multiply_by_lin_func_value(f, (*lines)[line], P.x, -P.y);
+        ++line;
+
+        if (naf & 3)
+        {
+            for (const auto& [P, lines] : inputs)
+                multiply_by_lin_func_value(f, (*lines)[line], P.x, P.y);
+            ++line;
+        }
+        naf >>= 2;
+    }
 
-    lin_func(T, nQ2, t);
-    multiply_by_lin_func_value(f, t, P.x, P.y);
+    for (; line != NUM_LINES; ++line)
+    {
+        for (const auto& [P, lines] : inputs)
+            multiply_by_lin_func_value(f, (*lines)[line], P.x, P.y);
+    }
 
     return f;
 }
 
+/// The validated G2 point's line functions shared by the cache and the pairing checks.
+using G2Prepared = std::shared_ptr<const G2Lines>;
+
+/// The bounded process-wide cache of the validated G2 points and their line functions.
+///
+/// The ZK verifiers use the same verification key G2 points in every pairing check so
+/// the validation and the line functions computation can be skipped for them.
+/// The entries are keyed by the G2 point coordinates as in the precompile input
+/// and only the valid points are stored. When full, the least recently used entry is replaced.
+class G2Cache
+{
+    /// The maximum number of entries. Each entry takes about 17 KiB.
+    static constexpr size_t CAPACITY = 64;
+
+    struct Entry
+    {
+        ExtPoint key;
+        G2Prepared lines;
+        uint64_t last_use = 0;
+    };
+
+    std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    uint64_t m_clock = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
+public:
+    /// Returns the line functions of the cached G2 point or null if not in the cache.
+    G2Prepared find(const ExtPoint& q) noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        const auto it = std::ranges::find(m_entries, q, &Entry::key);
+        if (it == m_entries.end())
+        {
+            ++m_misses;
+            return nullptr;
+        }
+        ++m_hits;
+        it->last_use = ++m_clock;
+        return it->lines;
+    }
+
+    /// Inserts the valid G2 point with the copy of its line functions.
+    /// The point is not cached if the entry cannot be allocated.
+    void insert(const ExtPoint& q, const G2Lines& lines) noexcept
+    {
+        try
+        {
+            auto shared_lines = std::make_shared<const G2Lines>(lines);
+
+            const std::lock_guard lock{m_mutex};
+            if (std::ranges::find(m_entries, q, &Entry::key) != m_entries.end())
+                return;  // Inserted in the meantime by another thread.
+
+            Entry e{q, std::move(shared_lines), ++m_clock};
+            if (m_entries.size() < CAPACITY)
+                m_entries.push_back(std::move(e));
+            else
+                *std::ranges::min_element(m_entries, {}, &Entry::last_use) = std::move(e);
+        }
+        catch (const std::bad_alloc&)
+        {
+            // Skip caching. The cache is only an optimization.
+        }
+    }
+
+    G2CacheStats stats() noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        return {m_hits, m_misses, m_entries.size()};
+    }
+
+    void clear() noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        m_entries.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+};
+
+G2Cache& g2_cache() noexcept
+{
+    static G2Cache cache;
+    return cache;
+}
+
 /// Final exponentiation formula.
 /// Based on https://eprint.iacr.org/2010/354.pdf 4.2 Algorithm 31.
 Fq12 final_exp(const Fq12& v) noexcept
@@ -128,12 +269,52 @@ Fq12 final_exp(const Fq12& v) noexcept
 }
 }  // namespace
 
+G2CacheStats g2_cache_stats() noexcept
+{
+    return g2_cache().stats();
+}
+
+void g2_cache_clear() noexcept
+{
+    g2_cache().clear();
+}
+
 std::optional<bool> pairing_check(std::span<const std::pair<Point, ExtPoint>> pairs) noexcept
 {
     if (pairs.empty())
         return true;
 
+    // The pairs are processed in batches of Miller loops run simultaneously.
+    // The line functions of the G2 points not found in the cache are computed into
+    // the stack buffer (about 17 KiB each) so the check itself does not allocate.
+    static constexpr size_t MAX_BATCH_SIZE = 16;
+    static constexpr size_t MAX_BATCH_PREPARED = 4;
+
+    // The distinct G2 points of the batch. The same G2 point is often used in multiple pairs
+    // so it is looked up in the cache, validated and prepared once.
+    struct G2Point
+    {
+        ExtPoint key;
+        G2Prepared cached;  ///< Keeps the cached line functions alive.
+        const G2Lines* lines = nullptr;
+    };
+    std::array<G2Point, MAX_BATCH_SIZE> g2_points;
+    std::array<G2Lines, MAX_BATCH_PREPARED> prepared;
+    std::array<MillerLoopInput, MAX_BATCH_SIZE> inputs;
+    size_t num_g2_points = 0;
+    size_t num_prepared = 0;
+    size_t num_inputs = 0;
     auto f = Fq12::one();
+    auto& cache = g2_cache();
+
+    // The product of the Miller loops of the batches is the Miller loop of all the pairs.
+    const auto run_batch = [&] {
+        if (num_inputs != 0)
+            f = f * multi_miller_loop({inputs.data(), num_inputs});
+        num_g2_points = 0;
+        num_prepared = 0;
+        num_inputs = 0;
+    };
 
     for (const auto& [p, q] : pairs)
     {
@@ -156,15 +337,48 @@ std::optional<bool> pairing_check(std::span<const std::pair<Point, ExtPoint>> pa
         if (!g1_is_inf && !is_on_curve(P_aff))
             return std::nullopt;
 
-        // Verify that Q in on curve and in proper subgroup. This subgroup is much smaller than
-        // group containing all the points from twisted curve over Fq2 field.
-        if (!g2_is_inf && (!is_on_twisted_curve(Q_aff) || !g2_subgroup_check(Q_aff)))
-            return std::nullopt;
+        if (g2_is_inf)
+            continue;
+
+        if (num_inputs == MAX_BATCH_SIZE || num_prepared == MAX_BATCH_PREPARED)
+            run_batch();
+
+        const auto batch_g2_points = std::span{g2_points.data(), num_g2_points};
+        const G2Lines* lines = nullptr;
+        if (const auto it = std::ranges::find(batch_g2_points, q, &G2Point::key);
+            it != batch_g2_points.end())
+        {
+            lines = it->lines;
+        }
+        else
+        {
+            // Verify that Q in on curve and in proper subgroup. This subgroup is much smaller
+            // than group containing all the points from twisted curve over Fq2 field.
+            // The cached points have been already verified.
+            auto cached = cache.find(q);
+            if (!cached && (!is_on_twisted_curve(Q_aff) || !g2_subgroup_check(Q_aff)))
+                return std::nullopt;
+
+            // If any of the points is infinity it means that miller_loop returns 1. so we can
+            // skip it.
+            if (g1_is_inf)
+                continue;
+
+            lines = cached.get();
+            if (lines == nullptr)
+            {
+                auto& q_lines = prepared[num_prepared++];
+                q_lines = prepare_lines(Q_aff);
+                cache.insert(q, q_lines);
+                lines = &q_lines;
+            }
+            g2_points[num_g2_points++] = {q, std::move(cached), lines};
+        }
 
-        // If any of the points is infinity it means that miller_loop returns 1. so we can skip it.
-        if (!g1_is_inf && !g2_is_inf)
-            f = f * miller_loop(Q_aff, P_aff);
+        if (!g1_is_inf)
+            inputs[num_inputs++] = {P_aff, lines};
     }
+    run_batch();
 
     // final exp is calculated on accumulated value
     return final_exp(f) == Fq12::one();
@@ -15,7 +15,7 @@ class BaseFieldElem
 {
     using ValueT = typename ConfigT::ValueT;
 
-    static constexpr ModArith<ValueT> Fp = ConfigT::MOD_ARITH;
+    static constexpr auto Fp = ConfigT::MOD_ARITH;
 
     ValueT m_value;
 
@@ -62,6 +62,22 @@ public:
         return BaseFieldElem(Fp.sub(ValueT{0}, e.m_value));
     }
 
+    /// Computes (a + b)⋅(c + d).
+    ///
+    /// For the sparse modulus (see SparseModArith) the sums are not reduced
+    /// (lazy reduction) because the multiplication accepts the inputs less than 2⋅mod.
+    friend constexpr BaseFieldElem mul_sums(const BaseFieldElem& a, const BaseFieldElem& b,
+        const BaseFieldElem& c, const BaseFieldElem& d) noexcept
+    {
+        if constexpr (Fp.is_sparse())
+            return BaseFieldElem(Fp.mul(a.m_value + b.m_value, c.m_value + d.m_value));
+        else
+        {
+            return BaseFieldElem(
+                Fp.mul(Fp.add(a.m_value, b.m_value), Fp.add(c.m_value, d.m_value)));
+        }
+    }
+
     friend constexpr bool operator==(
         const BaseFieldElem& e1, const BaseFieldElem& e2) noexcept = default;
 };
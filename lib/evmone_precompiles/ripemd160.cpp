@@ -3,12 +3,17 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "ripemd160.hpp"
+#include <evmmax/cpu_features.hpp>
 #include <algorithm>
 #include <array>
 #include <bit>
 #include <cstdint>
 #include <utility>
 
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
 #if defined(_LIBCPP_VERSION) && _LIBCPP_VERSION < 180000
 // libc++ before version 18 has incorrect std::rotl signature
 // https://github.com/llvm/llvm-project/commit/45500fa08acdf3849de9de470cdee5f4c8ee2f32
@@ -39,6 +44,8 @@ constexpr size_t R = 5;      ///< Number of rounds.
 constexpr size_t B = 16;     ///< Number of steps per round and words in a block.
 constexpr size_t N = R * B;  ///< Number of steps.
 
+constexpr size_t BLOCK_SIZE = B * sizeof(uint32_t);  ///< Size of a block in bytes.
+
 using State = std::array<uint32_t, RIPEMD160_HASH_SIZE / sizeof(uint32_t)>;
 
 using BinaryFunction = uint32_t (*)(uint32_t, uint32_t, uint32_t) noexcept;
@@ -186,35 +193,263 @@ void compress(State& h, const std::byte* block) noexcept
         t[i] = h[(i + 1) % M] + z[0][(i + 2) % M] + z[1][(i + 3) % M];
     h = t;
 }
-}  // namespace
 
-void ripemd160(std::byte hash[RIPEMD160_HASH_SIZE], const std::byte* data, size_t size) noexcept
+constexpr State INITIAL_STATE{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+/// The input message split into the full blocks and the padded tail (1 or 2 blocks).
+struct PaddedMessage
 {
-    static constexpr size_t BLOCK_SIZE = B * sizeof(uint32_t);
-    State h{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+    const std::byte* data = nullptr;  ///< The input data.
+    size_t num_full_blocks = 0;       ///< The number of full input blocks.
+    size_t num_blocks = 0;            ///< The total number of blocks including the padding.
+
+    /// The tail of the input followed by the padding and the length.
+    std::array<std::byte, 2 * BLOCK_SIZE> padding{};
 
-    const auto tail_size = size % BLOCK_SIZE;
-    for (const auto tail_begin = &data[size - tail_size]; data != tail_begin; data += BLOCK_SIZE)
-        compress(h, data);
+    PaddedMessage() noexcept = default;
 
+    PaddedMessage(const std::byte* input, size_t size) noexcept
+      : data{input}, num_full_blocks{size / BLOCK_SIZE}
     {
-        std::array<std::byte, BLOCK_SIZE> padding_block{};
-        const auto padded_tail_end = std::copy_n(data, tail_size, padding_block.data());
+        const auto tail_size = size % BLOCK_SIZE;
+        const auto padded_tail_end =
+            std::copy_n(&data[size - tail_size], tail_size, padding.data());
         *padded_tail_end = std::byte{0x80};  // The padding bit placed just after the input bytes.
 
         // Store the input length in bits in the last two words of the padded block.
         const auto length_in_bits = uint64_t{size} * 8;
-        const auto length_begin = &padding_block[BLOCK_SIZE - sizeof(length_in_bits)];
+        auto length_begin = &padding[BLOCK_SIZE - sizeof(length_in_bits)];
+        size_t num_padding_blocks = 1;
         if (padded_tail_end >= length_begin)  // If not enough space, create one more block.
         {
-            compress(h, padding_block.data());
-            padding_block = {};
+            length_begin += BLOCK_SIZE;
+            num_padding_blocks = 2;
         }
         store_le(length_begin, length_in_bits);
-        compress(h, padding_block.data());
+        num_blocks = num_full_blocks + num_padding_blocks;
+    }
+
+    /// Returns the pointer to the i-th block.
+    [[nodiscard]] const std::byte* block(size_t i) const noexcept
+    {
+        return i < num_full_blocks ? &data[i * BLOCK_SIZE] :
+                                     &padding[(i - num_full_blocks) * BLOCK_SIZE];
+    }
+};
+
+#if defined(__x86_64__)
+
+/// The number of messages hashed at once by the multi-buffer implementation.
+constexpr size_t LANES = 8;
+
+// NOLINTBEGIN(portability-simd-intrinsics)
+
+/// The multi-buffer versions of the binary functions f₁…f₅ (see binary_functions).
+template <size_t I>
+__attribute__((target("avx2"))) inline __m256i f_x8(__m256i x, __m256i y, __m256i z) noexcept
+{
+    const auto ones = _mm256_set1_epi32(-1);
+    if constexpr (I == 0)
+        return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+    else if constexpr (I == 1)
+        return _mm256_xor_si256(_mm256_and_si256(_mm256_xor_si256(y, z), x), z);
+    else if constexpr (I == 2)
+        return _mm256_xor_si256(_mm256_or_si256(x, _mm256_xor_si256(y, ones)), z);
+    else if constexpr (I == 3)
+        return _mm256_xor_si256(_mm256_and_si256(_mm256_xor_si256(x, y), z), y);
+    else
+        return _mm256_xor_si256(x, _mm256_or_si256(y, _mm256_xor_si256(z, ones)));
+}
+
+template <int S>
+__attribute__((target("avx2"))) inline __m256i rotl_x8(__m256i x) noexcept
+{
+    return _mm256_or_si256(_mm256_slli_epi32(x, S), _mm256_srli_epi32(x, 32 - S));
+}
+
+/// The multi-buffer version of step() for the line i: the lane l of the vectors processes
+/// the message l. The w are the message words of the current blocks of all messages.
+template <size_t i, size_t J>
+__attribute__((target("avx2"))) [[gnu::always_inline]] inline void line_step_x8(
+    __m256i z[5], const __m256i w[B]) noexcept
+{
+    static constexpr auto I = J / B;  // round index
+    static constexpr auto fi = i == 0 ? I : R - 1 - I;
+
+    const auto a = z[0];
+    const auto b = z[1];
+    const auto c = z[2];
+    const auto d = z[3];
+    const auto e = z[4];
+
+    const auto k = _mm256_set1_epi32(static_cast<int>(constants[i][I]));
+    const auto t = _mm256_add_epi32(
+        _mm256_add_epi32(a, f_x8<fi>(b, c, d)), _mm256_add_epi32(w[word_index[i][J]], k));
+
+    z[0] = e;
+    z[1] = _mm256_add_epi32(rotl_x8<rotate_amount[i][J]>(t), e);
+    z[2] = b;
+    z[3] = rotl_x8<10>(c);
+    z[4] = d;
+}
+
+template <size_t... J>
+__attribute__((target("avx2"))) [[gnu::always_inline]] inline void steps_x8(
+    __m256i z[L][5], const __m256i w[B], std::index_sequence<J...>) noexcept
+{
+    ((line_step_x8<0, J>(z[0], w), line_step_x8<1, J>(z[1], w)), ...);
+}
+
+/// Multi-buffer RIPEMD-160: hashes LANES messages at once using AVX2.
+/// The messages may have different lengths: the lanes of the messages without more blocks
+/// are computed but discarded.
+__attribute__((target("avx2"))) void ripemd160_avx2_x8(
+    State states[LANES], const PaddedMessage messages[LANES]) noexcept
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-cstyle-cast)
+    alignas(32) uint32_t h_words[5][LANES];
+    size_t max_num_blocks = 0;
+    for (size_t l = 0; l < LANES; ++l)
+    {
+        for (size_t i = 0; i < 5; ++i)
+            h_words[i][l] = states[l][i];
+        max_num_blocks = std::max(max_num_blocks, messages[l].num_blocks);
+    }
+    __m256i h[5];
+    for (size_t i = 0; i < 5; ++i)
+        h[i] = _mm256_load_si256((const __m256i*)h_words[i]);
+
+    for (size_t n = 0; n < max_num_blocks; ++n)
+    {
+        // Transpose the blocks to the vectors of the message words.
+        alignas(32) uint32_t words[B][LANES];
+        alignas(32) uint32_t active[LANES];
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            const auto& m = messages[l];
+            active[l] = n < m.num_blocks ? ~uint32_t{0} : 0;
+            const auto block = m.block(std::min(n, m.num_blocks - 1));
+            for (size_t j = 0; j < B; ++j)
+                words[j][l] = load_le<uint32_t>(&block[j * sizeof(uint32_t)]);
+        }
+        __m256i w[B];
+        for (size_t j = 0; j < B; ++j)
+            w[j] = _mm256_load_si256((const __m256i*)words[j]);
+
+        __m256i z[L][5];
+        for (size_t i = 0; i < L; ++i)
+            std::copy_n(h, 5, z[i]);
+        steps_x8(z, w, std::make_index_sequence<N>{});
+
+        // Update the hash values of the active lanes.
+        const auto mask = _mm256_load_si256((const __m256i*)active);
+        __m256i t[5];
+        for (size_t i = 0; i < 5; ++i)
+        {
+            t[i] = _mm256_add_epi32(
+                _mm256_add_epi32(h[(i + 1) % 5], z[0][(i + 2) % 5]), z[1][(i + 3) % 5]);
+        }
+        for (size_t i = 0; i < 5; ++i)
+            h[i] = _mm256_blendv_epi8(h[i], t[i], mask);
+    }
+
+    for (size_t i = 0; i < 5; ++i)
+        _mm256_store_si256((__m256i*)h_words[i], h[i]);
+    for (size_t l = 0; l < LANES; ++l)
+    {
+        for (size_t i = 0; i < 5; ++i)
+            states[l][i] = h_words[i][l];
     }
+    // NOLINTEND(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+// NOLINTEND(portability-simd-intrinsics)
+
+/// The multi-buffer implementation if available for the CPU.
+void (*ripemd160_x8_best)(State states[LANES], const PaddedMessage messages[LANES]) noexcept =
+    nullptr;
+
+/// The multi-buffer implementation supported by the CPU (see set_ripemd160_batch_implementation()).
+void (*ripemd160_x8_supported)(
+    State states[LANES], const PaddedMessage messages[LANES]) noexcept = nullptr;
+
+__attribute__((constructor)) void select_ripemd160_implementation() noexcept
+{
+    if (evmmax::cpu_features().avx2)
+        ripemd160_x8_supported = ripemd160_avx2_x8;
+    ripemd160_x8_best = ripemd160_x8_supported;
+}
+
+#endif
+}  // namespace
+
+void ripemd160(std::byte hash[RIPEMD160_HASH_SIZE], const std::byte* data, size_t size) noexcept
+{
+    State h = INITIAL_STATE;
+
+    const PaddedMessage message{data, size};
+    for (size_t i = 0; i < message.num_blocks; ++i)
+        compress(h, message.block(i));
 
     for (const auto e : h)
         hash = store_le(hash, e);
 }
+
+void ripemd160_batch(std::byte hashes[][RIPEMD160_HASH_SIZE],
+    std::span<const std::span<const std::byte>> inputs) noexcept
+{
+    size_t n = 0;
+#if defined(__x86_64__)
+    if (ripemd160_x8_best != nullptr)
+    {
+        // Hash the groups of LANES messages with the multi-buffer implementation.
+        // The remaining messages are hashed one by one.
+        for (; n + LANES <= inputs.size(); n += LANES)
+        {
+            PaddedMessage messages[LANES];
+            State states[LANES];
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                messages[l] = {inputs[n + l].data(), inputs[n + l].size()};
+                states[l] = INITIAL_STATE;
+            }
+            ripemd160_x8_best(states, messages);
+
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                auto hash = hashes[n + l];
+                for (const auto e : states[l])
+                    hash = store_le(hash, e);
+            }
+        }
+    }
+#endif
+
+    for (; n < inputs.size(); ++n)
+        ripemd160(hashes[n], inputs[n].data(), inputs[n].size());
+}
+
+const char* ripemd160_batch_implementation() noexcept
+{
+#if defined(__x86_64__)
+    if (ripemd160_x8_best != nullptr)
+        return "avx2";
+#endif
+    return "sequential";
+}
+
+bool set_ripemd160_batch_implementation(std::string_view name) noexcept
+{
+#if defined(__x86_64__)
+    if (name == "sequential")
+        ripemd160_x8_best = nullptr;
+    else if (name == "avx2" && ripemd160_x8_supported != nullptr)
+        ripemd160_x8_best = ripemd160_x8_supported;
+    else
+        return false;
+    return true;
+#else
+    return name == "sequential";
+#endif
+}
 }  // namespace evmone::crypto
@@ -4,6 +4,8 @@
 
 #pragma once
 #include <cstddef>
+#include <span>
+#include <string_view>
 
 namespace evmone::crypto
 {
@@ -18,4 +20,22 @@ static constexpr std::size_t RIPEMD160_HASH_SIZE = 160 / 8;
 void ripemd160(
     std::byte hash[RIPEMD160_HASH_SIZE], const std::byte* data, std::size_t size) noexcept;
 
+/// Computes the RIPEMD-160 hashes of multiple inputs.
+///
+/// On x86-64 CPUs with AVX2 the groups of 8 inputs are hashed at once (multi-buffer RIPEMD-160).
+/// Otherwise, the inputs are hashed one by one.
+///
+/// @param[out] hashes  The result message digests are written to the provided memory:
+///                     hashes[i] is the hash of the inputs[i].
+/// @param      inputs  The input data.
+void ripemd160_batch(std::byte hashes[][RIPEMD160_HASH_SIZE],
+    std::span<const std::span<const std::byte>> inputs) noexcept;
+
+/// Returns the name of the ripemd160_batch() implementation in use: "avx2" or "sequential".
+const char* ripemd160_batch_implementation() noexcept;
+
+/// Selects the ripemd160_batch() implementation by its name (for testing).
+/// Returns false and keeps the current one if the implementation is not supported by the CPU.
+bool set_ripemd160_batch_implementation(std::string_view name) noexcept;
+
 }  // namespace evmone::crypto
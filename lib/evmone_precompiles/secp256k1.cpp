@@ -3,6 +3,9 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "secp256k1.hpp"
 #include <ethash/keccak.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
 
 namespace evmmax::secp256k1
 {
@@ -14,6 +17,177 @@ constexpr auto B3 = Fp.to_mont(7 * 3);
 
 constexpr Point G{0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798_u256,
     0x483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8_u256};
+
+/// The cube root of unity in the field (in Montgomery form).
+/// The endomorphism φ(x, y) = (βx, y) is the multiplication by the λ cube root of unity mod N:
+/// φ(P) = [λ]P, where λ = 0x5363ad4cc05c30e0a5261c028812645a122e22ea20816678df02967c1b23bd72.
+constexpr auto Beta =
+    Fp.to_mont(0x7ae96a2b657c07106e64479eac3434e99cf0497512f58995c1396c28719501ee_u256);
+
+/// The wNAF width for the fixed base point G.
+constexpr int G_WNAF_WIDTH = 8;
+
+/// The wNAF width for the variable base point.
+constexpr int WNAF_WIDTH = 5;
+
+/// The maximum number of wNAF digits of the 128-bit scalar halves.
+constexpr size_t MAX_WNAF_SIZE = 130;
+
+/// The GLV decomposition parameters for the endomorphism φ (see Beta).
+/// The constants are from libsecp256k1.
+constexpr ecc::GLVBasis<uint256> GLV{
+    .a1 = 0x3086d221a7d46bcde86c90e49284eb15_u256,
+    .minus_b1 = 0xe4437ed6010e88286f547fa90abfe4c3_u256,
+    .a2 = 0x114ca50f7a8e2f3f657c1108d9d44cfd8_u256,
+    .b2 = 0x3086d221a7d46bcde86c90e49284eb15_u256,
+    .g1 = 0x3086d221a7d46bcde86c90e49284eb153daa8a1471e8ca7fe893209a45dbb031_u256,
+    .g2 = 0xe4437ed6010e88286f547fa90abfe4c4221208ac9df506c61571b4ae8ac47f71_u256,
+    .shift = 384,
+};
+
+/// The precomputed odd multiples of G and of φ(G) as affine points in Montgomery form.
+struct GTable
+{
+    static constexpr size_t SIZE = size_t{1} << (G_WNAF_WIDTH - 2);
+
+    std::array<Point, SIZE> g;
+    std::array<Point, SIZE> g_endo;
+};
+
+/// Returns the G multiples table. It is built on the first use.
+const GTable& g_table() noexcept
+{
+    static const auto table = [] {
+        std::array<ecc::ProjPoint<uint256>, GTable::SIZE> points;
+        points[0] = ecc::to_proj(Fp, G);
+        const auto g2 = ecc::dbl(Fp, points[0], B3);
+        for (size_t i = 1; i < GTable::SIZE; ++i)
+            points[i] = ecc::add(Fp, points[i - 1], g2, B3);
+
+        GTable t;
+        ecc::batch_to_affine(Fp, field_inv, points, t.g);
+        for (size_t i = 0; i < GTable::SIZE; ++i)
+            t.g_endo[i] = {Fp.mul(t.g[i].x, Beta), t.g[i].y};
+        return t;
+    }();
+    return table;
+}
+
+/// Computes [u1]G + [u2]R, where R is the affine point in Montgomery form.
+///
+/// Both scalars are split with the GLV decomposition and the four ~128-bit scalar multiplications
+/// are interleaved (the Straus-Shamir trick) so they share the doublings. The multiples of G
+/// are taken from the precomputed table. The multiples of R are computed here.
+ecc::ProjPoint<uint256> mul_add_g(const uint256& u1, const Point& r, const uint256& u2) noexcept
+{
+    static constexpr size_t R_TABLE_SIZE = size_t{1} << (WNAF_WIDTH - 2);
+
+    const auto& gt = g_table();
+
+    // Odd multiples of R and φ(R).
+    std::array<ecc::ProjPoint<uint256>, R_TABLE_SIZE> rt;
+    std::array<ecc::ProjPoint<uint256>, R_TABLE_SIZE> rt_endo;
+    rt[0] = {r.x, r.y, Fp.to_mont(1)};
+    const auto r2 = ecc::dbl(Fp, rt[0], B3);
+    for (size_t i = 1; i < R_TABLE_SIZE; ++i)
+        rt[i] = ecc::add(Fp, rt[i - 1], r2, B3);
+    for (size_t i = 0; i < R_TABLE_SIZE; ++i)
+        rt_endo[i] = {Fp.mul(rt[i].x, Beta), rt[i].y, rt[i].z};
+
+    const auto s1 = ecc::split_scalar(GLV, u1);
+    const auto s2 = ecc::split_scalar(GLV, u2);
+
+    std::array<int8_t, MAX_WNAF_SIZE> g_digits;
+    std::array<int8_t, MAX_WNAF_SIZE> g_endo_digits;
+    std::array<int8_t, MAX_WNAF_SIZE> r_digits;
+    std::array<int8_t, MAX_WNAF_SIZE> r_endo_digits;
+    const auto g_size = ecc::to_wnaf<G_WNAF_WIDTH>(g_digits, s1.k1);
+    const auto g_endo_size = ecc::to_wnaf<G_WNAF_WIDTH>(g_endo_digits, s1.k2);
+    const auto r_size = ecc::to_wnaf<WNAF_WIDTH>(r_digits, s2.k1);
+    const auto r_endo_size = ecc::to_wnaf<WNAF_WIDTH>(r_endo_digits, s2.k2);
+    const auto size = std::max({g_size, g_endo_size, r_size, r_endo_size});
+
+    // Returns the table entry for the i-th wNAF digit (with the negation applied)
+    // or nothing if the digit is zero.
+    const auto select = [](const auto& table, const auto& digits, size_t num_digits, size_t i,
+                            bool neg) noexcept {
+        const auto d = i < num_digits ? digits[i] : 0;
+        std::optional<std::remove_cvref_t<decltype(table[0])>> e;
+        if (d != 0)
+        {
+            e = table[static_cast<size_t>(d < 0 ? -d : d) / 2];
+            if ((d < 0) != neg)
+                e->y = Fp.sub(0, e->y);
+        }
+        return e;
+    };
+
+    ecc::ProjPoint<uint256> p;
+    for (size_t i = size; i-- != 0;)
+    {
+        p = ecc::dbl(Fp, p, B3);
+
+        if (const auto e = select(gt.g, g_digits, g_size, i, s1.k1_neg))
+            p = ecc::add(Fp, p, *e, B3);
+        if (const auto e = select(gt.g_endo, g_endo_digits, g_endo_size, i, s1.k2_neg))
+            p = ecc::add(Fp, p, *e, B3);
+        if (const auto e = select(rt, r_digits, r_size, i, s2.k1_neg))
+            p = ecc::add(Fp, p, *e, B3);
+        if (const auto e = select(rt_endo, r_endo_digits, r_endo_size, i, s2.k2_neg))
+            p = ecc::add(Fp, p, *e, B3);
+    }
+    return p;
+}
+
+/// Checks if the signature values r and s are within [1, N-1].
+constexpr bool is_valid_signature(const uint256& r, const uint256& s) noexcept
+{
+    return r != 0 && r < Order && s != 0 && s < Order;
+}
+
+/// Computes the public key point Q in projective coordinates from the valid signature
+/// with r⁻¹ mod N (in Montgomery form) provided.
+///
+/// @return The point Q (possibly the infinity)
+///         or std::nullopt if the point R with the x coordinate r does not exist.
+std::optional<ecc::ProjPoint<uint256>> recover_point(const ModArith<uint256>& n,
+    const ethash::hash256& e, const uint256& r, const uint256& r_inv, const uint256& s,
+    bool v) noexcept
+{
+    // Follows
+    // https://en.wikipedia.org/wiki/Elliptic_Curve_Digital_Signature_Algorithm#Public_key_recovery
+
+    // 1. Validate r and s are within [1, n-1]. This has been done by the caller.
+    assert(is_valid_signature(r, s));
+
+    // 3. Hash of the message is already calculated in e.
+    // 4. Convert hash e to z field element by doing z = e % n.
+    //    https://www.rfc-editor.org/rfc/rfc6979#section-2.3.2
+    //    We can do this by n - e because n > 2^255.
+    static_assert(Order > 1_u256 << 255);
+    auto z = intx::be::load<uint256>(e.bytes);
+    if (z >= Order)
+        z -= Order;
+
+    // 5. Calculate u1 and u2.
+    const auto z_mont = n.to_mont(z);
+    const auto z_neg = n.sub(0, z_mont);
+    const auto u1_mont = n.mul(z_neg, r_inv);
+    const auto u1 = n.from_mont(u1_mont);
+
+    const auto s_mont = n.to_mont(s);
+    const auto u2_mont = n.mul(s_mont, r_inv);
+    const auto u2 = n.from_mont(u2_mont);
+
+    // 2. Calculate y coordinate of R from r and v.
+    const auto r_mont = Fp.to_mont(r);
+    const auto y_mont = calculate_y(Fp, r_mont, v);
+    if (!y_mont.has_value())
+        return std::nullopt;
+
+    // 6. Calculate public key point Q = [u1]G + [u2]R.
+    return mul_add_g(u1, {r_mont, *y_mont}, u2);
+}
 }  // namespace
 
 // FIXME: Change to "uncompress_point".
@@ -43,7 +217,7 @@ Point add(const Point& p, const Point& q) noexcept
 
     // b3 == 21 for y^2 == x^3 + 7
     const auto r = ecc::add(Fp, pp, pq, B3);
-    return ecc::to_affine(Fp, field_inv, r);
+    return ecc::to_affine(Fp, ecc::inv, r);
 }
 
 Point mul(const Point& p, const uint256& c) noexcept
@@ -55,7 +229,7 @@ Point mul(const Point& p, const uint256& c) noexcept
         return {0, 0};
 
     const auto r = ecc::mul(Fp, ecc::to_proj(Fp, p), c, B3);
-    return ecc::to_affine(Fp, field_inv, r);
+    return ecc::to_affine(Fp, ecc::inv, r);
 }
 
 evmc::address to_address(const Point& pt) noexcept
@@ -75,53 +249,16 @@ evmc::address to_address(const Point& pt) noexcept
 std::optional<Point> secp256k1_ecdsa_recover(
     const ethash::hash256& e, const uint256& r, const uint256& s, bool v) noexcept
 {
-    // Follows
-    // https://en.wikipedia.org/wiki/Elliptic_Curve_Digital_Signature_Algorithm#Public_key_recovery
-
-    // 1. Validate r and s are within [1, n-1].
-    if (r == 0 || r >= Order || s == 0 || s >= Order)
+    if (!is_valid_signature(r, s))
         return std::nullopt;
 
-    // 3. Hash of the message is already calculated in e.
-    // 4. Convert hash e to z field element by doing z = e % n.
-    //    https://www.rfc-editor.org/rfc/rfc6979#section-2.3.2
-    //    We can do this by n - e because n > 2^255.
-    static_assert(Order > 1_u256 << 255);
-    auto z = intx::be::load<uint256>(e.bytes);
-    if (z >= Order)
-        z -= Order;
-
-
     const ModArith<uint256> n{Order};
-
-    // 5. Calculate u1 and u2.
-    const auto r_n = n.to_mont(r);
-    const auto r_inv = scalar_inv(n, r_n);
-
-    const auto z_mont = n.to_mont(z);
-    const auto z_neg = n.sub(0, z_mont);
-    const auto u1_mont = n.mul(z_neg, r_inv);
-    const auto u1 = n.from_mont(u1_mont);
-
-    const auto s_mont = n.to_mont(s);
-    const auto u2_mont = n.mul(s_mont, r_inv);
-    const auto u2 = n.from_mont(u2_mont);
-
-    // 2. Calculate y coordinate of R from r and v.
-    const auto r_mont = Fp.to_mont(r);
-    const auto y_mont = calculate_y(Fp, r_mont, v);
-    if (!y_mont.has_value())
+    const auto r_inv = n.inv(n.to_mont(r));
+    const auto pQ = recover_point(n, e, r, r_inv, s, v);
+    if (!pQ.has_value())
         return std::nullopt;
-    const auto y = Fp.from_mont(*y_mont);
 
-    // 6. Calculate public key point Q.
-    const auto R = ecc::to_proj(Fp, {r, y});
-    const auto pG = ecc::to_proj(Fp, G);
-    const auto T1 = ecc::mul(Fp, pG, u1, B3);
-    const auto T2 = ecc::mul(Fp, R, u2, B3);
-    const auto pQ = ecc::add(Fp, T1, T2, B3);
-
-    const auto Q = ecc::to_affine(Fp, field_inv, pQ);
+    const auto Q = ecc::to_affine(Fp, ecc::inv, *pQ);
 
     // Any other validity check needed?
     if (Q.is_inf())
@@ -140,6 +277,49 @@ std::optional<evmc::address> ecrecover(
     return to_address(*point);
 }
 
+void ecrecover_batch(std::span<const RecoveryInput> inputs,
+    std::span<std::optional<evmc::address>> results) noexcept
+{
+    assert(results.size() == inputs.size());
+
+    const ModArith<uint256> n{Order};
+
+    // Compute all r⁻¹ with a single inversion. Invalid signatures are marked with 0.
+    std::vector<uint256> r_inv(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        if (is_valid_signature(inputs[i].r, inputs[i].s))
+            r_inv[i] = n.to_mont(inputs[i].r);
+    }
+    ecc::batch_inv(n, ecc::inv, std::span{r_inv});
+
+    // Compute the public key points in projective coordinates.
+    // The infinity and the failed recoveries are marked with the infinity point (z = 0).
+    std::vector<ecc::ProjPoint<uint256>> points(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        if (r_inv[i] == 0)
+            continue;
+        const auto& [e, r, s, v] = inputs[i];
+        if (const auto pQ = recover_point(n, e, r, r_inv[i], s, v); pQ.has_value())
+            points[i] = *pQ;
+    }
+
+    // Convert the points to affine coordinates with a single inversion.
+    std::vector<Point> affine_points(inputs.size());
+    ecc::batch_to_affine(Fp, ecc::inv, points, affine_points);
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        const auto& Q = affine_points[i];
+        if (Q.is_inf())
+        {
+            results[i] = std::nullopt;
+            continue;
+        }
+        results[i] = to_address({Fp.from_mont(Q.x), Fp.from_mont(Q.y)});
+    }
+}
+
 uint256 field_inv(const ModArith<uint256>& m, const uint256& x) noexcept
 {
     // Computes modular exponentiation
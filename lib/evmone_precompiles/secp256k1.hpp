@@ -7,6 +7,7 @@
 #include <ethash/hash_types.hpp>
 #include <evmc/evmc.hpp>
 #include <optional>
+#include <span>
 
 namespace evmmax::secp256k1
 {
@@ -66,4 +67,26 @@ std::optional<Point> secp256k1_ecdsa_recover(
 std::optional<evmc::address> ecrecover(
     const ethash::hash256& e, const uint256& r, const uint256& s, bool v) noexcept;
 
+/// The input of the public key recovery: the hash of the message and its ECDSA signature.
+struct RecoveryInput
+{
+    ethash::hash256 e;
+    uint256 r;
+    uint256 s;
+    bool v = false;
+};
+
+/// Batched ecrecover().
+///
+/// Recovers the addresses of the signers of multiple messages. The results are the same as
+/// of ecrecover() applied to every input, but the inversions of r mod N
+/// and the final field inversions of the public key points are shared by the whole batch
+/// (using Montgomery's trick).
+///
+/// @param      inputs   The hashes of the messages with the signatures.
+/// @param[out] results  The recovered addresses or std::nullopt for invalid signatures.
+///                      Must be of the size of the @p inputs.
+void ecrecover_batch(std::span<const RecoveryInput> inputs,
+    std::span<std::optional<evmc::address>> results) noexcept;
+
 }  // namespace evmmax::secp256k1
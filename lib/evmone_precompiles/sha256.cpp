@@ -11,13 +11,14 @@
 /// https://github.com/Mysticial/FeatureDetector (Author: Alexander Yee)
 
 #include "sha256.hpp"
+#include <evmmax/cpu_features.hpp>
+#include <algorithm>
 #include <bit>
 #include <cstdint>
 #include <cstring>
 
 #if defined(__x86_64__)
 
-#include <cpuid.h>
 #include <x86intrin.h>
 
 #elif defined(__aarch64__) && defined(__APPLE__)
@@ -243,6 +244,17 @@ static void sha_256_generic(uint32_t h[8], const std::byte* input, size_t len)
 
 static void (*sha_256_best)(uint32_t h[8], const std::byte* input, size_t len) = sha_256_generic;
 
+/// The number of messages hashed at once by the multi-buffer implementation.
+static constexpr size_t SHA256_LANES = 8;
+
+/// The multi-buffer implementation if available for the CPU (see sha256_batch()).
+static void (*sha_256_x8_best)(
+    uint32_t h[8][SHA256_LANES], BufferState states[], size_t num_lanes) = nullptr;
+
+/// The multi-buffer implementation supported by the CPU, even if not the best one.
+static void (*sha_256_x8_supported)(
+    uint32_t h[8][SHA256_LANES], BufferState states[], size_t num_lanes) = nullptr;
+
 #if defined(__x86_64__)
 
 __attribute__((target("bmi,bmi2"))) static void sha_256_x86_bmi(
@@ -481,41 +493,127 @@ __attribute__((target("sha,sse4.1"))) static void sha_256_x86_sha(
 
 #pragma GCC diagnostic pop
 
-// https://stackoverflow.com/questions/6121792/how-to-check-if-a-cpu-supports-the-sse3-instruction-set
-static void cpuid(int info[4], int InfoType)  // NOLINT(readability-non-const-parameter)
+__attribute__((target("avx2"))) static inline __m256i rotr_x8(__m256i x, int n)
 {
-    __cpuid_count(InfoType, 0, info[0], info[1], info[2], info[3]);
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
 }
 
-__attribute__((constructor)) static void select_sha256_implementation()
+/// Multi-buffer SHA256: hashes up to SHA256_LANES messages at once using AVX2.
+/// The lane l of the vectors processes the message l: the h[i][l] is the i-th hash value word
+/// of the message l. The messages may have different lengths: the lanes of the messages
+/// without more chunks are computed but discarded.
+__attribute__((target("avx2"))) static void sha_256_x86_avx2_x8(
+    uint32_t h[8][SHA256_LANES], BufferState states[], size_t num_lanes)
 {
-    int info[4];
-    cpuid(info, 0);
-    const int nIds = info[0];
-
-    bool hw_sse41 = false;
-    bool hw_bmi1 = false;
-    bool hw_bmi2 = false;
-    bool hw_sha = false;
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-cstyle-cast)
+    // NOLINTBEGIN(portability-simd-intrinsics)
+    __m256i hv[8];
+    for (unsigned i = 0; i < 8; i++)
+        hv[i] = _mm256_loadu_si256((const __m256i*)h[i]);
 
-    if (nIds >= 0x00000001)
+    uint8_t chunks[SHA256_LANES][CHUNK_SIZE]{};
+    while (true)
     {
-        cpuid(info, 0x00000001);
-        hw_sse41 = (info[2] & (1 << 19)) != 0;
-    }
-    if (nIds >= 0x00000007)
-    {
-        cpuid(info, 0x00000007);
-        hw_bmi1 = (info[1] & (1 << 3)) != 0;
-        hw_bmi2 = (info[1] & (1 << 8)) != 0;
-        hw_sha = (info[1] & (1 << 29)) != 0;
+        alignas(32) uint32_t active[SHA256_LANES]{};
+        bool any_active = false;
+        for (size_t l = 0; l < num_lanes; l++)
+        {
+            if (calc_chunk(chunks[l], &states[l]))
+            {
+                active[l] = ~uint32_t{0};
+                any_active = true;
+            }
+        }
+        if (!any_active)
+            break;
+
+        /* Transpose the chunks to the vectors of the big-endian words. */
+        alignas(32) uint32_t words[16][SHA256_LANES];
+        for (unsigned j = 0; j < 16; j++)
+        {
+            for (size_t l = 0; l < SHA256_LANES; l++)
+            {
+                const uint8_t* p = &chunks[l][j * 4];
+                words[j][l] = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 |
+                              (uint32_t)p[3];
+            }
+        }
+        __m256i w[16];
+        for (unsigned j = 0; j < 16; j++)
+            w[j] = _mm256_load_si256((const __m256i*)words[j]);
+
+        __m256i ah[8];
+        for (unsigned i = 0; i < 8; i++)
+            ah[i] = hv[i];
+
+        for (unsigned i = 0; i < 64; i++)
+        {
+            const unsigned j = i & 0xf;
+            if (i >= 16)
+            {
+                const __m256i w1 = w[(j + 1) & 0xf];
+                const __m256i w14 = w[(j + 14) & 0xf];
+                const __m256i s0 = _mm256_xor_si256(
+                    _mm256_xor_si256(rotr_x8(w1, 7), rotr_x8(w1, 18)), _mm256_srli_epi32(w1, 3));
+                const __m256i s1 =
+                    _mm256_xor_si256(_mm256_xor_si256(rotr_x8(w14, 17), rotr_x8(w14, 19)),
+                        _mm256_srli_epi32(w14, 10));
+                w[j] = _mm256_add_epi32(
+                    _mm256_add_epi32(w[j], s0), _mm256_add_epi32(w[(j + 9) & 0xf], s1));
+            }
+
+            const __m256i s1 = _mm256_xor_si256(
+                _mm256_xor_si256(rotr_x8(ah[4], 6), rotr_x8(ah[4], 11)), rotr_x8(ah[4], 25));
+            const __m256i ch =
+                _mm256_xor_si256(_mm256_and_si256(ah[4], ah[5]), _mm256_andnot_si256(ah[4], ah[6]));
+            const __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(ah[7], s1),
+                _mm256_add_epi32(_mm256_add_epi32(ch, _mm256_set1_epi32((int)k[i])), w[j]));
+            const __m256i s0 = _mm256_xor_si256(
+                _mm256_xor_si256(rotr_x8(ah[0], 2), rotr_x8(ah[0], 13)), rotr_x8(ah[0], 22));
+            const __m256i maj =
+                _mm256_xor_si256(_mm256_and_si256(ah[0], _mm256_xor_si256(ah[1], ah[2])),
+                    _mm256_and_si256(ah[1], ah[2]));
+            const __m256i temp2 = _mm256_add_epi32(s0, maj);
+
+            ah[7] = ah[6];
+            ah[6] = ah[5];
+            ah[5] = ah[4];
+            ah[4] = _mm256_add_epi32(ah[3], temp1);
+            ah[3] = ah[2];
+            ah[2] = ah[1];
+            ah[1] = ah[0];
+            ah[0] = _mm256_add_epi32(temp1, temp2);
+        }
+
+        /* Add the compressed chunk to the current hash value of the active lanes. */
+        const __m256i mask = _mm256_load_si256((const __m256i*)active);
+        for (unsigned i = 0; i < 8; i++)
+            hv[i] = _mm256_blendv_epi8(hv[i], _mm256_add_epi32(hv[i], ah[i]), mask);
     }
 
-    if (hw_sse41 && hw_sha)
+    for (unsigned i = 0; i < 8; i++)
+        _mm256_storeu_si256((__m256i*)h[i], hv[i]);
+    // NOLINTEND(portability-simd-intrinsics)
+    // NOLINTEND(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+__attribute__((constructor)) static void select_sha256_implementation()
+{
+    const auto& cpu = evmmax::cpu_features();
+
+    if (cpu.avx2)
+        sha_256_x8_supported = sha_256_x86_avx2_x8;
+
+    // The SHA extensions compute a single message faster than AVX2 computes 8 messages
+    // so the multi-buffer implementation is only used on CPUs without them.
+    if (!cpu.sha)
+        sha_256_x8_best = sha_256_x8_supported;
+
+    if (cpu.sse41 && cpu.sha)
     {
         sha_256_best = sha_256_x86_sha;
     }
-    else if (hw_bmi1 && hw_bmi2)
+    else if (cpu.bmi1 && cpu.bmi2)
     {
         sha_256_best = sha_256_x86_bmi;
     }
@@ -746,4 +844,66 @@ void sha256(std::byte hash[SHA256_HASH_SIZE], const std::byte* data, size_t size
     }
 }
 
+void sha256_batch(
+    std::byte hashes[][SHA256_HASH_SIZE], std::span<const std::span<const std::byte>> inputs)
+{
+    size_t n = 0;
+    if (sha_256_x8_best != nullptr)
+    {
+        // Hash the groups of SHA256_LANES messages with the multi-buffer implementation.
+        // The remaining messages are hashed one by one.
+        for (; n + SHA256_LANES <= inputs.size(); n += SHA256_LANES)
+        {
+            uint32_t h[8][SHA256_LANES];
+            static constexpr uint32_t h0[] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+            for (unsigned i = 0; i < 8; i++)
+                std::fill_n(h[i], SHA256_LANES, h0[i]);
+
+            BufferState states[SHA256_LANES]{
+                {inputs[n + 0].data(), inputs[n + 0].size()},
+                {inputs[n + 1].data(), inputs[n + 1].size()},
+                {inputs[n + 2].data(), inputs[n + 2].size()},
+                {inputs[n + 3].data(), inputs[n + 3].size()},
+                {inputs[n + 4].data(), inputs[n + 4].size()},
+                {inputs[n + 5].data(), inputs[n + 5].size()},
+                {inputs[n + 6].data(), inputs[n + 6].size()},
+                {inputs[n + 7].data(), inputs[n + 7].size()},
+            };
+            sha_256_x8_best(h, states, SHA256_LANES);
+
+            for (size_t l = 0; l < SHA256_LANES; l++)
+            {
+                std::byte* hash = hashes[n + l];
+                for (unsigned i = 0, j = 0; i < 8; i++)
+                {
+                    hash[j++] = static_cast<std::byte>(h[i][l] >> 24);
+                    hash[j++] = static_cast<std::byte>(h[i][l] >> 16);
+                    hash[j++] = static_cast<std::byte>(h[i][l] >> 8);
+                    hash[j++] = static_cast<std::byte>(h[i][l]);
+                }
+            }
+        }
+    }
+
+    for (; n < inputs.size(); n++)
+        sha256(hashes[n], inputs[n].data(), inputs[n].size());
+}
+
+const char* sha256_batch_implementation() noexcept
+{
+    return sha_256_x8_best != nullptr ? "avx2" : "sequential";
+}
+
+bool set_sha256_batch_implementation(std::string_view name) noexcept
+{
+    if (name == "sequential")
+        sha_256_x8_best = nullptr;
+    else if (name == "avx2" && sha_256_x8_supported != nullptr)
+        sha_256_x8_best = sha_256_x8_supported;
+    else
+        return false;
+    return true;
+}
+
 }  // namespace evmone::crypto
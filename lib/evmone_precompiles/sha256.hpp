@@ -4,6 +4,8 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
+#include <string_view>
 
 namespace evmone::crypto
 {
@@ -16,4 +18,23 @@ static constexpr std::size_t SHA256_HASH_SIZE = 256 / 8;
 /// @param      data  The input data.
 /// @param      size  The size of the input data.
 void sha256(std::byte hash[SHA256_HASH_SIZE], const std::byte* data, size_t size);
+
+/// Computes the SHA256 hashes of multiple inputs.
+///
+/// On x86-64 CPUs with AVX2 but without the SHA extensions the groups of 8 inputs are hashed
+/// at once (multi-buffer SHA256). This is faster than hashing the inputs one by one,
+/// especially for the inputs of similar sizes. Otherwise, the inputs are hashed one by one.
+///
+/// @param[out] hashes  The result message digests are written to the provided memory:
+///                     hashes[i] is the hash of the inputs[i].
+/// @param      inputs  The input data.
+void sha256_batch(
+    std::byte hashes[][SHA256_HASH_SIZE], std::span<const std::span<const std::byte>> inputs);
+
+/// Returns the name of the sha256_batch() implementation in use: "avx2" or "sequential".
+const char* sha256_batch_implementation() noexcept;
+
+/// Selects the sha256_batch() implementation by its name (for testing).
+/// Returns false and keeps the current one if the implementation is not supported by the CPU.
+bool set_sha256_batch_implementation(std::string_view name) noexcept;
 }  // namespace evmone::crypto
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+
+# evmone: Fast Ethereum Virtual Machine implementation
+# Copyright 2025 The evmone Authors.
+# SPDX-License-Identifier: Apache-2.0
+
+# Creates the gas calibration report: the execution time per unit of gas
+# of the EVM instructions and precompiles.
+#
+# The inputs are the JSON reports of evmone-bench (the synthetic benchmarks
+# of the instructions) and evmone-precompiles-bench (the precompiles over the grid of inputs):
+#
+#   evmone-bench --benchmark_filter=synth --benchmark_out=synth.json
+#   evmone-precompiles-bench --benchmark_out=precompiles.json
+#   gas_calibration.py synth.json precompiles.json > report.csv
+#
+# The benchmarks are reported as CSV sorted from the slowest per unit of gas.
+# The benchmarks slower than the median by the given factor are flagged as outliers:
+# these are the candidates for the DoS vectors.
+# The synthetic benchmarks include the overhead of the benchmark loop so the instructions
+# should be compared with each other rather than with the precompiles directly.
+# The precompiles benchmarked with the reference implementations of silkpre
+# (evmone-precompiles-bench built with EVMONE_PRECOMPILES_SILKPRE) are tagged
+# and excluded from the median and the outlier ranking.
+
+import argparse
+import csv
+import json
+import re
+import statistics
+import sys
+
+# The names of the silkpre implementations in the precompile benchmark template arguments.
+REFERENCE_IMPLEMENTATIONS = {"silkpre", "libsecp256k1", "gmp", "libff"}
+
+
+def is_reference(name):
+    return not REFERENCE_IMPLEMENTATIONS.isdisjoint(re.findall(r"[\w:]+", name))
+
+
+def load_benchmarks(path):
+    with open(path) as f:
+        report = json.load(f)
+    for b in report["benchmarks"]:
+        # Skip the aggregates (mean, median, stddev) of repeated runs.
+        if b.get("run_type", "iteration") != "iteration":
+            continue
+        # The time_per_gas counter is in seconds.
+        if "time_per_gas" not in b or b["time_per_gas"] <= 0:
+            continue
+        yield {
+            "name": b["name"],
+            "reference": is_reference(b["name"]),
+            "ns_per_gas": b["time_per_gas"] * 1e9,
+            "gas_per_iteration": b.get("gas_per_call", b.get("gas_used", 0)),
+        }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Creates the gas calibration report.")
+    parser.add_argument("reports", nargs="+", help="Google Benchmark JSON reports")
+    parser.add_argument("--outlier-factor", type=float, default=3.0,
+                        help="flag benchmarks slower per gas than the median by this factor")
+    args = parser.parse_args()
+
+    rows = [r for path in args.reports for r in load_benchmarks(path)]
+    if not rows:
+        sys.exit("no benchmarks with the time_per_gas counter found")
+
+    ranked = [r["ns_per_gas"] for r in rows if not r["reference"]]
+    if not ranked:
+        sys.exit("no evmone benchmarks with the time_per_gas counter found")
+    median = statistics.median(ranked)
+    # The reference implementations are listed after the ranked benchmarks.
+    rows.sort(key=lambda r: (r["reference"], -r["ns_per_gas"]))
+
+    w = csv.writer(sys.stdout)
+    w.writerow(["name", "ns_per_gas", "relative_to_median", "gas_per_iteration", "outlier",
+                "reference"])
+    for r in rows:
+        relative = r["ns_per_gas"] / median
+        outlier = not r["reference"] and relative > args.outlier_factor
+        w.writerow([r["name"], f"{r['ns_per_gas']:.4f}", f"{relative:.2f}",
+                    int(r["gas_per_iteration"]), int(outlier), int(r["reference"])])
+
+
+if __name__ == "__main__":
+    main()
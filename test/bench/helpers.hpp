@@ -143,6 +143,8 @@ inline void bench_execute(benchmark::State& state, evmc::VM& vm, bytes_view code
     using benchmark::Counter;
     state.counters["gas_used"] = Counter(static_cast<double>(iteration_gas_used));
     state.counters["gas_rate"] = Counter(static_cast<double>(total_gas_used), Counter::kIsRate);
+    state.counters["time_per_gas"] =
+        Counter(static_cast<double>(total_gas_used), Counter::kIsRate | Counter::kInvert);
 }
 
 
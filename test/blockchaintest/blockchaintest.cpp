@@ -6,6 +6,7 @@
 #include <CLI/CLI.hpp>
 #include <evmone/evmone.h>
 #include <evmone/version.h>
+#include <evmone_precompiles/bls.hpp>
 #include <gtest/gtest.h>
 #include <iostream>
 
@@ -85,8 +86,14 @@ int main(int argc, char* argv[])
         bool trace_flag = false;
         app.add_flag("--trace", trace_flag, "Enable EVM tracing");
 
+        size_t msm_threads = 1;
+        app.add_option("--msm-threads", msm_threads,
+            "Number of threads computing the big BLS12-381 MSMs");
+
         CLI11_PARSE(app, argc, argv);
 
+        evmone::crypto::bls::set_msm_parallelism(msm_threads);
+
         evmc::VM vm{evmc_create_evmone()};
 
         if (trace_flag)
@@ -5,6 +5,7 @@
 #include "../statetest/statetest.hpp"
 #include "../utils/utils.hpp"
 #include "blockchaintest.hpp"
+#include <algorithm>
 
 namespace evmone::test
 {
@@ -108,8 +109,17 @@ static TestBlock load_test_block(const json::json& j, const RevisionSchedule& re
 
     if (auto it = j.find("transactions"); it != j.end())
     {
+        std::vector<bool> sender_missing;
         for (const auto& tx : *it)
+        {
             tb.transactions.emplace_back(from_json<Transaction>(tx));
+            sender_missing.push_back(!tx.contains("sender"));
+        }
+
+        // `sender` is not provided for transactions in invalid blocks.
+        // Recover the missing senders of the block's transactions at once.
+        if (std::ranges::find(sender_missing, true) != sender_missing.end())
+            state::recover_signers(tb.transactions, sender_missing);
     }
 
     return tb;
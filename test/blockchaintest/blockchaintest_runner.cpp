@@ -9,6 +9,7 @@
 #include "../test/statetest/statetest.hpp"
 #include "blockchaintest.hpp"
 #include <gtest/gtest.h>
+#include <memory_resource>
 
 namespace evmone::test
 {
@@ -49,13 +50,17 @@ TransitionResult apply_block(TestState& state, evmc::VM& vm, const state::BlockI
 
     int64_t cumulative_gas_used = 0;
 
+    // The intermediate state of all transactions is allocated from the block-scoped arena
+    // and released at once when the block is applied.
+    std::pmr::monotonic_buffer_resource block_arena;
+
     for (size_t i = 0; i < txs.size(); ++i)
     {
         const auto& tx = txs[i];
 
         const auto computed_tx_hash = keccak256(rlp::encode(tx));
-        auto res = test::transition(
-            block_state, block, block_hashes, tx, rev, vm, block_gas_left, blob_gas_left);
+        auto res = test::transition(block_state, block, block_hashes, tx, rev, vm, block_gas_left,
+            blob_gas_left, &block_arena);
 
         if (holds_alternative<std::error_code>(res))
         {
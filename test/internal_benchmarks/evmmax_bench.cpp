@@ -4,6 +4,11 @@
 
 #include <benchmark/benchmark.h>
 #include <evmmax/evmmax.hpp>
+#include <evmone_precompiles/bn254.hpp>
+#include <evmone_precompiles/ecc.hpp>
+#include <evmone_precompiles/secp256k1.hpp>
+#include <utility>
+#include <vector>
 
 using namespace intx;
 
@@ -11,6 +16,9 @@ namespace
 {
 constexpr auto bn254 = 0x30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47_u256;
 constexpr auto secp256k1 = 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f_u256;
+constexpr auto secp256k1_n = evmmax::secp256k1::Order;
+constexpr auto bls12_381 =
+    0x1a0111ea397fe69a4b1ba7b6434bacd764774b84f38512bf6730d2a0f6b0f6241eabfffeb153ffffb9feffffffffaaab_u384;
 
 template <typename UintT, const UintT& Mod>
 void evmmax_add(benchmark::State& state)
@@ -53,6 +61,110 @@ void evmmax_mul(benchmark::State& state)
         b = m.mul(b, a);
     }
 }
+
+template <typename UintT, const UintT& Mod>
+auto make_mul_inputs(const evmmax::ModArith<UintT>& m, size_t n)
+{
+    std::vector<UintT> x(n);
+    std::vector<UintT> y(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] = m.to_mont(Mod / (i + 2));
+        y[i] = m.to_mont(Mod / (i + 3));
+    }
+    return std::pair{std::move(x), std::move(y)};
+}
+
+/// The reference for evmmax_mul_batch: the same multiplications with the portable ModArith::mul().
+template <typename UintT, const UintT& Mod>
+void evmmax_mul_loop(benchmark::State& state)
+{
+    const evmmax::ModArith<UintT> m{Mod};
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto [x, y] = make_mul_inputs<UintT, Mod>(m, n);
+    std::vector<UintT> r(n);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i < n; ++i)
+            r[i] = m.mul(x[i], y[i]);
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename UintT, const UintT& Mod>
+void evmmax_mul_batch(benchmark::State& state)
+{
+    const evmmax::ModArith<UintT> m{Mod};
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto [x, y] = make_mul_inputs<UintT, Mod>(m, n);
+    std::vector<UintT> r(n);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        m.mul_batch(r, x, y);
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(evmmax::mul_batch_implementation());
+}
+
+template <const uint256& Mod, evmmax::ecc::InvFn<uint256> Inv>
+void evmmax_inv(benchmark::State& state)
+{
+    const evmmax::ModArith<uint256> m{Mod};
+    auto a = m.to_mont(Mod / 2);
+
+    while (state.KeepRunning())
+        a = Inv(m, a);
+    benchmark::DoNotOptimize(a);
+}
+
+/// Makes the n multiples of the bn254 generator in projective coordinates.
+std::vector<evmmax::ecc::ProjPoint<uint256>> make_bn254_points(
+    const evmmax::ModArith<uint256>& m, size_t n)
+{
+    const auto b3 = m.to_mont(3 * 3);
+    const auto g = evmmax::ecc::to_proj(m, evmmax::bn254::Point{1, 2});
+    std::vector<evmmax::ecc::ProjPoint<uint256>> points(n);
+    auto q = g;
+    for (auto& p : points)
+    {
+        p = q;
+        q = evmmax::ecc::add(m, q, g, b3);
+    }
+    return points;
+}
+
+void bn254_to_affine_loop(benchmark::State& state)
+{
+    const evmmax::ModArith<uint256> m{bn254};
+    const auto points = make_bn254_points(m, static_cast<size_t>(state.range(0)));
+    std::vector<evmmax::bn254::Point> r(points.size());
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i < points.size(); ++i)
+            r[i] = evmmax::ecc::to_affine(m, evmmax::bn254::field_inv, points[i]);
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bn254_batch_to_affine(benchmark::State& state)
+{
+    const evmmax::ModArith<uint256> m{bn254};
+    const auto points = make_bn254_points(m, static_cast<size_t>(state.range(0)));
+    std::vector<evmmax::bn254::Point> r(points.size());
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        evmmax::ecc::batch_to_affine(m, evmmax::bn254::field_inv, points, r);
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
 }  // namespace
 
 BENCHMARK_TEMPLATE(evmmax_add, uint256, bn254);
@@ -61,3 +173,22 @@ BENCHMARK_TEMPLATE(evmmax_sub, uint256, bn254);
 BENCHMARK_TEMPLATE(evmmax_sub, uint256, secp256k1);
 BENCHMARK_TEMPLATE(evmmax_mul, uint256, bn254);
 BENCHMARK_TEMPLATE(evmmax_mul, uint256, secp256k1);
+BENCHMARK_TEMPLATE(evmmax_mul, uint384, bls12_381);
+
+// The CPU-specific batch Montgomery multiplication vs the loop of ModArith::mul().
+BENCHMARK_TEMPLATE(evmmax_mul_loop, uint256, bn254)->Arg(8)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(evmmax_mul_batch, uint256, bn254)->Arg(8)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(evmmax_mul_loop, uint384, bls12_381)->Arg(8)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(evmmax_mul_batch, uint384, bls12_381)->Arg(8)->Arg(64)->Arg(1024);
+
+// The generic safegcd inversion vs the modulus-specific addition chains.
+BENCHMARK_TEMPLATE(evmmax_inv, bn254, evmmax::ecc::inv<uint256>);
+BENCHMARK_TEMPLATE(evmmax_inv, bn254, evmmax::bn254::field_inv);
+BENCHMARK_TEMPLATE(evmmax_inv, secp256k1, evmmax::ecc::inv<uint256>);
+BENCHMARK_TEMPLATE(evmmax_inv, secp256k1, evmmax::secp256k1::field_inv);
+BENCHMARK_TEMPLATE(evmmax_inv, secp256k1_n, evmmax::ecc::inv<uint256>);
+BENCHMARK_TEMPLATE(evmmax_inv, secp256k1_n, evmmax::secp256k1::scalar_inv);
+
+// The conversion of projective points to affine one by one vs with a single inversion.
+BENCHMARK(bn254_to_affine_loop)->Arg(1)->Arg(8)->Arg(64)->Arg(1024);
+BENCHMARK(bn254_batch_to_affine)->Arg(1)->Arg(8)->Arg(64)->Arg(1024);
@@ -0,0 +1,102 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <evmc/evmc.hpp>
+#include <test/state/flat_map.hpp>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using evmc::bytes32;
+
+/// The copy of state::StorageValue to not depend on the full state library.
+struct StorageValue
+{
+    bytes32 current;
+    bytes32 original;
+    evmc_access_status access_status = EVMC_ACCESS_COLD;
+};
+
+using StdStorage = std::unordered_map<bytes32, StorageValue>;
+using FlatStorage = evmone::state::FlatMap<bytes32, StorageValue>;
+
+/// Generates the sequence of storage keys accessed by a single transaction.
+///
+/// The Solidity-like layout is modelled: few fixed slots (small integers, e.g. reentrancy lock,
+/// total supply) are accessed repeatedly and the mapping slots (Keccak outputs,
+/// e.g. balances, allowances) are mostly accessed twice (SLOAD followed by SSTORE).
+std::vector<bytes32> generate_keys(size_t num_mapping_keys, size_t num_fixed_slots)
+{
+    std::mt19937_64 rng{num_mapping_keys};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<bytes32> keys;
+    for (size_t i = 0; i < num_mapping_keys; ++i)
+    {
+        bytes32 key;
+        for (size_t j = 0; j < sizeof(key); j += sizeof(uint64_t))
+        {
+            const auto w = rng();
+            std::memcpy(&key.bytes[j], &w, sizeof(w));
+        }
+        keys.emplace_back(key);
+        keys.emplace_back(evmc::bytes32{i % num_fixed_slots});
+        keys.emplace_back(key);
+    }
+    return keys;
+}
+
+/// Simulates the SLOAD/SSTORE pattern of a transaction:
+/// the storage cache starts empty, the missing entries are loaded and all entries are updated.
+template <typename MapT>
+void storage_access(benchmark::State& state)
+{
+    const auto num_keys = static_cast<size_t>(state.range(0));
+    const auto keys = generate_keys(num_keys, 4);
+
+    for (auto _ : state)
+    {
+        MapT storage;
+        for (const auto& key : keys)
+        {
+            const auto [it, missing] = storage.try_emplace(key);
+            if (missing)
+                it->second = {key, key};
+            it->second.current.bytes[0] ^= 1;
+            it->second.access_status = EVMC_ACCESS_WARM;
+        }
+        benchmark::DoNotOptimize(storage);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+
+/// Simulates the SLOAD-heavy access to the already warm storage.
+template <typename MapT>
+void storage_load_warm(benchmark::State& state)
+{
+    const auto num_keys = static_cast<size_t>(state.range(0));
+    const auto keys = generate_keys(num_keys, 4);
+
+    MapT storage;
+    for (const auto& key : keys)
+        storage.try_emplace(key);
+
+    for (auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(storage.find(key)->second);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+
+#define ARGS ->RangeMultiplier(4)->Range(4, 4096)
+
+BENCHMARK_TEMPLATE(storage_access, StdStorage) ARGS;
+BENCHMARK_TEMPLATE(storage_access, FlatStorage) ARGS;
+BENCHMARK_TEMPLATE(storage_load_warm, StdStorage) ARGS;
+BENCHMARK_TEMPLATE(storage_load_warm, FlatStorage) ARGS;
+
+}  // namespace
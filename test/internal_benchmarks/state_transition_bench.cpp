@@ -0,0 +1,217 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <evmone/evmone.h>
+#include <test/state/host.hpp>
+#include <test/state/precompiles.hpp>
+#include <test/state/state.hpp>
+#include <test/state/test_state.hpp>
+#include <test/utils/bytecode.hpp>
+#include <memory_resource>
+
+namespace
+{
+using namespace evmc::literals;
+using namespace evmone;
+using namespace evmone::state;
+using namespace evmone::test;
+
+/// The memory resource counting the allocations passed to the upstream resource.
+class CountingResource : public std::pmr::memory_resource
+{
+    std::pmr::memory_resource* m_upstream;
+
+public:
+    size_t num_allocations = 0;
+
+    explicit CountingResource(std::pmr::memory_resource* upstream) noexcept : m_upstream{upstream}
+    {}
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++num_allocations;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        m_upstream->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+constexpr auto TOKEN = 0x70c3e2_address;
+constexpr auto REVERTER = 0x2e7e2e2_address;
+constexpr auto LOOPER = 0x100900_address;
+constexpr auto REV = EVMC_CANCUN;
+
+/// The block of transactions from distinct senders replayed on top of the same pre-state.
+struct BlockReplay
+{
+    TestState pre;
+    BlockInfo block{.number = 1, .gas_limit = 1'000'000'000, .coinbase = 0xc014bace_address};
+    TestBlockHashes block_hashes;
+    std::vector<Transaction> txs;
+    std::vector<TransactionProperties> txs_props;
+
+    void add_tx(const address& to, bytes data, int64_t gas_limit)
+    {
+        const auto sender = evmc::address{txs.size() + 1};
+        pre[sender] = {.balance = 1'000'000'000'000};
+
+        const auto& tx = txs.emplace_back(Transaction{
+            .type = Transaction::Type::eip1559,
+            .data = std::move(data),
+            .gas_limit = gas_limit,
+            .max_gas_price = 1,
+            .max_priority_gas_price = 1,
+            .sender = sender,
+            .to = to,
+        });
+        const auto props = validate_transaction(pre, block, tx, REV, block.gas_limit, 0);
+        txs_props.emplace_back(std::get<TransactionProperties>(props));
+    }
+};
+
+/// The block of token-transfer-like transactions.
+/// Each transaction updates the sender's and the recipient's storage slots, emits a log
+/// and performs a reverted nested call.
+BlockReplay token_transfers()
+{
+    BlockReplay replay;
+    replay.pre[TOKEN] = {.code = sstore(OP_CALLER, add(sload(OP_CALLER), 1)) +
+                                 sstore(calldataload(0), add(sload(calldataload(0)), 1)) +
+                                 mstore(0, OP_CALLER) + push(32) + push(0) + OP_LOG0 +
+                                 call(REVERTER).gas(20'000) + OP_POP};
+    replay.pre[REVERTER] = {.code = sstore(1, 1) + revert(0, 0)};
+    for (uint64_t i = 0; i < 200; ++i)
+        replay.add_tx(TOKEN, bytes(evmc::bytes32{i + 1000}), 200'000);
+    return replay;
+}
+
+/// The block of revert-heavy transactions.
+/// Each transaction calls in a loop (with value transfer) the contract which modifies
+/// multiple storage and transient storage slots and then reverts.
+BlockReplay failing_calls()
+{
+    static constexpr uint64_t NUM_CALLS = 100;
+    static constexpr uint64_t NUM_SLOTS = 8;
+
+    bytecode failing;
+    for (uint64_t i = 0; i < NUM_SLOTS; ++i)
+        failing += sstore(i, OP_GAS) + tstore(i, OP_GAS);
+    failing += revert(0, 0);
+
+    BlockReplay replay;
+    replay.pre[REVERTER] = {.code = failing};
+    // The loop counter is kept on the stack. The JUMPDEST is at offset 2, after PUSH1.
+    replay.pre[LOOPER] = {.balance = NUM_CALLS,
+        .code = push(NUM_CALLS) + OP_JUMPDEST + call(REVERTER).value(1).gas(300'000) + OP_POP +
+                push(1) + OP_SWAP1 + OP_SUB + jumpi(2, OP_DUP1)};
+    for (uint64_t i = 0; i < 10; ++i)
+        replay.add_tx(LOOPER, {}, 30'000'000);
+    return replay;
+}
+
+/// Replays the block transactions.
+/// The intermediate state of all transactions is allocated either from the global heap
+/// or from the block-scoped monotonic arena. The "arena_eligible_allocs" counter reports
+/// the number of the allocations of the intermediate state containers (the ones routed
+/// through the memory resource) reaching the global heap per block.
+/// The other allocations (e.g. the VM execution state, the precompile outputs, the logs)
+/// are not counted because they cannot use the arena.
+template <BlockReplay (*WorkloadFn)(), bool UseArena>
+void block_replay(benchmark::State& state)
+{
+    static const auto replay = WorkloadFn();
+    evmc::VM vm{evmc_create_evmone()};
+
+    CountingResource heap{std::pmr::new_delete_resource()};
+    for (auto _ : state)
+    {
+        std::pmr::monotonic_buffer_resource block_arena{&heap};
+        auto* const memory =
+            UseArena ? static_cast<std::pmr::memory_resource*>(&block_arena) : &heap;
+
+        for (size_t i = 0; i < replay.txs.size(); ++i)
+        {
+            const auto receipt = transition(replay.pre, replay.block, replay.block_hashes,
+                replay.txs[i], REV, vm, replay.txs_props[i], memory);
+            if (receipt.status != EVMC_SUCCESS)
+                return state.SkipWithError("transaction failed");
+            benchmark::DoNotOptimize(receipt);
+        }
+    }
+
+    using benchmark::Counter;
+    state.counters["arena_eligible_allocs"] =
+        Counter(static_cast<double>(heap.num_allocations), Counter::kAvgIterations);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * replay.txs.size()));
+}
+
+BENCHMARK_TEMPLATE(block_replay, token_transfers, false);
+BENCHMARK_TEMPLATE(block_replay, token_transfers, true);
+BENCHMARK_TEMPLATE(block_replay, failing_calls, false);
+BENCHMARK_TEMPLATE(block_replay, failing_calls, true);
+
+/// The input of the ecrecover precompile with the valid signature.
+const auto ecrecover_input =
+    "18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c"
+    "000000000000000000000000000000000000000000000000000000000000001c"
+    "73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9aa6a5a75f"
+    "eeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549"_hex;
+
+/// Calls the precompile the same way as the CALL instruction does: through the Host
+/// with the full message pipeline (value transfer, touching, state checkpoint).
+template <PrecompileId Id, size_t InputSize>
+void precompile_call_host(benchmark::State& state)
+{
+    static constexpr auto CALLER = 0xca11e7_address;
+    const auto precompile_addr = address{stdx::to_underlying(Id)};
+    const auto input = Id == PrecompileId::ecrecover ? ecrecover_input : bytes(InputSize, 0xa5);
+
+    TestState pre;
+    pre[CALLER] = {.balance = 1};
+    State intra_state{pre};
+    BlockInfo block;
+    TestBlockHashes block_hashes;
+    Transaction tx;
+    evmc::VM vm{evmc_create_evmone()};
+    Host host{REV, vm, intra_state, block, block_hashes, tx};
+
+    const evmc_message msg{
+        .kind = EVMC_CALL,
+        .depth = 1,
+        .gas = 1'000'000,
+        .recipient = precompile_addr,
+        .sender = CALLER,
+        .input_data = input.data(),
+        .input_size = input.size(),
+        .code_address = precompile_addr,
+    };
+
+    for (auto _ : state)
+    {
+        const auto checkpoint = intra_state.checkpoint();
+        const auto result = host.call(msg);
+        if (result.status_code != EVMC_SUCCESS) [[unlikely]]
+            return state.SkipWithError("precompile call failed");
+        benchmark::DoNotOptimize(result.output_data[0]);
+        intra_state.rollback(checkpoint);
+    }
+}
+
+BENCHMARK_TEMPLATE(precompile_call_host, PrecompileId::identity, 32);
+BENCHMARK_TEMPLATE(precompile_call_host, PrecompileId::identity, 4096);
+BENCHMARK_TEMPLATE(precompile_call_host, PrecompileId::sha256, 32);
+BENCHMARK_TEMPLATE(precompile_call_host, PrecompileId::sha256, 4096);
+BENCHMARK_TEMPLATE(precompile_call_host, PrecompileId::ecrecover, 128);
+
+}  // namespace
@@ -4,10 +4,21 @@
 
 #include "../utils/utils.hpp"
 #include <benchmark/benchmark.h>
+#include <evmone_precompiles/bls.hpp>
+#include <evmone_precompiles/bn254.hpp>
+#include <evmone_precompiles/kzg.hpp>
+#include <evmone_precompiles/ripemd160.hpp>
+#include <evmone_precompiles/sha256.hpp>
+#include <intx/intx.hpp>
 #include <state/precompiles.hpp>
 #include <state/precompiles_internal.hpp>
 #include <array>
+#include <cassert>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <span>
+#include <vector>
 
 #ifdef EVMONE_PRECOMPILES_SILKPRE
 #include <state/precompiles_silkpre.hpp>
@@ -28,6 +39,14 @@ constexpr auto analyze<PrecompileId::identity> = identity_analyze;
 template <>
 constexpr auto analyze<PrecompileId::ecrecover> = ecrecover_analyze;
 template <>
+constexpr auto analyze<PrecompileId::sha256> = sha256_analyze;
+template <>
+constexpr auto analyze<PrecompileId::ripemd160> = ripemd160_analyze;
+template <>
+constexpr auto analyze<PrecompileId::expmod> = expmod_analyze;
+template <>
+constexpr auto analyze<PrecompileId::blake2bf> = blake2bf_analyze;
+template <>
 constexpr auto analyze<PrecompileId::ecadd> = ecadd_analyze;
 template <>
 constexpr auto analyze<PrecompileId::ecmul> = ecmul_analyze;
@@ -35,6 +54,20 @@ template <>
 [[maybe_unused]] constexpr auto analyze<PrecompileId::ecpairing> = ecpairing_analyze;
 template <>
 constexpr auto analyze<PrecompileId::point_evaluation> = point_evaluation_analyze;
+template <>
+constexpr auto analyze<PrecompileId::bls12_g1add> = bls12_g1add_analyze;
+template <>
+constexpr auto analyze<PrecompileId::bls12_g1msm> = bls12_g1msm_analyze;
+template <>
+constexpr auto analyze<PrecompileId::bls12_g2add> = bls12_g2add_analyze;
+template <>
+constexpr auto analyze<PrecompileId::bls12_g2msm> = bls12_g2msm_analyze;
+template <>
+constexpr auto analyze<PrecompileId::bls12_pairing_check> = bls12_pairing_check_analyze;
+template <>
+constexpr auto analyze<PrecompileId::bls12_map_fp_to_g1> = bls12_map_fp_to_g1_analyze;
+template <>
+constexpr auto analyze<PrecompileId::bls12_map_fp2_to_g2> = bls12_map_fp2_to_g2_analyze;
 
 template <PrecompileId>
 const inline std::array inputs{0};
@@ -45,6 +78,27 @@ const inline std::array inputs<PrecompileId::identity>{
     bytes(4096, 1),
 };
 
+/// Creates the BLAKE2b F input with the "abc" message block (EIP-152 test vector 5)
+/// and the given number of rounds.
+bytes blake2bf_input(uint32_t rounds)
+{
+    bytes input(sizeof(rounds), 0);
+    intx::be::unsafe::store(input.data(), rounds);
+    return input +
+           "48c9bdf267e6096a3ba7ca8485ae67bb2bf894fe72f36e3cf1361d5f3af54fa5"
+           "d182e6ad7f520e511f6c3e2b8c68059b6bbd41fbabd9831f79217e1319cde05b"
+           "6162630000000000000000000000000000000000000000000000000000000000"
+           "0000000000000000000000000000000000000000000000000000000000000000"
+           "0000000000000000000000000000000000000000000000000000000000000000"
+           "0000000000000000000000000000000000000000000000000000000000000000"
+           "0300000000000000000000000000000001"_hex;
+}
+
+template <>
+const inline std::array inputs<PrecompileId::blake2bf>{
+    blake2bf_input(12),
+};
+
 template <>
 const inline std::array inputs<PrecompileId::ecrecover>{
     "18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c"
@@ -138,12 +192,12 @@ const inline std::array inputs<PrecompileId::point_evaluation>{
     "01ff83fbe4488061b695d9e4632e9ab23c5b9dfb046241fac921659c2e3b6a4e5e88a0c20ef27ae5dea6e83a748115df152b207362c022a43c8ebbfbec73ea2a2b38376a1de4ed9abd35175ac422af7df2c6ddf1503979964b1d217747c108978969cc0fcbd47dba8b1e3cbba16920f3fc694fadbf203b55aa66aaf138a38ace946a7ccddc20f45d796cd60268df8a2487d06c11cdc50247c580c5dd25f6fb486053b73868038cb92c2ae6d429a7bde850177f31c9fde00ca824c8c59cd4ef49"_hex,
 };
 
-template <PrecompileId Id, ExecuteFn Fn>
+template <PrecompileId Id, ExecuteFn Fn, const auto& Inputs = inputs<Id>>
 void precompile(benchmark::State& state)
 {
     int64_t batch_gas_cost = 0;
     size_t max_output_size = 0;
-    for (const auto& input : inputs<Id>)
+    for (const auto& input : Inputs)
     {
         const auto r = analyze<Id>(input, EVMC_LATEST_STABLE_REVISION);
         batch_gas_cost += r.gas_cost;
@@ -151,12 +205,18 @@ void precompile(benchmark::State& state)
     }
     const auto output = std::make_unique_for_overwrite<uint8_t[]>(max_output_size);
 
-
     int64_t total_gas_used = 0;
-    while (state.KeepRunningBatch(inputs<Id>.size()))
+    while (state.KeepRunningBatch(Inputs.size()))
     {
-        for (const auto& input : inputs<Id>)
+        for (const auto& input : Inputs)
         {
+            // The gas costs are calibrated against the uncached execution:
+            // drop the results of the previous calls before every call.
+            if constexpr (Fn == ecpairing_execute)
+                evmmax::bn254::g2_cache_clear();
+            if constexpr (Fn == point_evaluation_execute)
+                evmone::crypto::kzg_cache_clear();
+
             const auto [status, _] = Fn(input.data(), input.size(), output.get(), max_output_size);
             if (status != EVMC_SUCCESS) [[unlikely]]
             {
@@ -170,10 +230,55 @@ void precompile(benchmark::State& state)
     using benchmark::Counter;
     state.counters["gas_used"] = Counter(static_cast<double>(batch_gas_cost));
     state.counters["gas_rate"] = Counter(static_cast<double>(total_gas_used), Counter::kIsRate);
+    state.counters["time_per_gas"] =
+        Counter(static_cast<double>(total_gas_used), Counter::kIsRate | Counter::kInvert);
+    // The benchmark iteration is a single call so the time is reported per call.
+    // Compare it with the average gas cost of the call to spot mispriced inputs.
+    state.counters["gas_per_call"] =
+        Counter(static_cast<double>(batch_gas_cost) / static_cast<double>(Inputs.size()));
 }
 
 BENCHMARK_TEMPLATE(precompile, PrecompileId::identity, identity_execute);
 
+namespace bench_identity
+{
+// The grid of input sizes: the per-word gas cost must dominate the base cost for big inputs.
+template <size_t N>
+const std::array inputs_size{bytes(N, 0xa5)};
+
+constexpr auto evmone_cpp = identity_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::identity, evmone_cpp, inputs_size<0>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::identity, evmone_cpp, inputs_size<32>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::identity, evmone_cpp, inputs_size<1024>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::identity, evmone_cpp, inputs_size<65536>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::identity, evmone_cpp, inputs_size<262144>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::identity, evmone_cpp, inputs_size<1048576>);
+
+/// Benchmarks the identity precompile call including the output handling.
+/// The call with the output buffer references the input (zero-copy),
+/// the call allocating the output copies the input.
+template <bool WithOutputBuffer>
+void identity_call(benchmark::State& state)
+{
+    const bytes input(static_cast<size_t>(state.range(0)), 0xa5);
+    evmc_message msg{.gas = std::numeric_limits<int64_t>::max()};
+    msg.code_address = evmc::address{0x04};
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+
+    bytes output_buffer;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = WithOutputBuffer ? call_precompile(EVMC_PRAGUE, msg, output_buffer) :
+                                          call_precompile(EVMC_PRAGUE, msg);
+        benchmark::DoNotOptimize(r.output_data);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(input.size()) * state.iterations());
+}
+BENCHMARK_TEMPLATE(identity_call, false)->RangeMultiplier(32)->Range(32, 1 << 20);
+BENCHMARK_TEMPLATE(identity_call, true)->RangeMultiplier(32)->Range(32, 1 << 20);
+}  // namespace bench_identity
+
 namespace bench_ecrecovery
 {
 constexpr auto evmmax_cpp = ecrecover_execute;
@@ -184,6 +289,119 @@ BENCHMARK_TEMPLATE(precompile, PrecompileId::ecrecover, libsecp256k1);
 #endif
 }  // namespace bench_ecrecovery
 
+namespace bench_sha256
+{
+template <size_t N>
+const std::array inputs_size{bytes(N, 0xa5)};
+
+constexpr auto evmone_cpp = sha256_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, evmone_cpp, inputs_size<32>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, evmone_cpp, inputs_size<128>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, evmone_cpp, inputs_size<1024>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, evmone_cpp, inputs_size<16384>);
+#ifdef EVMONE_PRECOMPILES_SILKPRE
+constexpr auto silkpre = silkpre_sha256_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, silkpre, inputs_size<32>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, silkpre, inputs_size<128>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, silkpre, inputs_size<1024>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::sha256, silkpre, inputs_size<16384>);
+#endif
+}  // namespace bench_sha256
+
+namespace bench_ripemd160
+{
+template <size_t N>
+const std::array inputs_size{bytes(N, 0xa5)};
+
+constexpr auto evmone_cpp = ripemd160_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, evmone_cpp, inputs_size<32>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, evmone_cpp, inputs_size<128>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, evmone_cpp, inputs_size<1024>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, evmone_cpp, inputs_size<16384>);
+#ifdef EVMONE_PRECOMPILES_SILKPRE
+constexpr auto silkpre = silkpre_ripemd160_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, silkpre, inputs_size<32>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, silkpre, inputs_size<128>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, silkpre, inputs_size<1024>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ripemd160, silkpre, inputs_size<16384>);
+#endif
+}  // namespace bench_ripemd160
+
+namespace bench_expmod
+{
+/// Creates the MODEXP input of the pseudo-random base and modulus (odd, with the top bit set)
+/// of the given size. This models the RSA signature verification.
+bytes rsa_input(size_t mod_size, const bytes& exp, uint32_t seed)
+{
+    const auto gen = [&seed](size_t size) {
+        bytes r(size, 0);
+        for (auto& b : r)
+        {
+            seed = seed * 1103515245 + 12345;
+            b = static_cast<uint8_t>(seed >> 16);
+        }
+        return r;
+    };
+
+    auto mod = gen(mod_size);
+    mod.front() |= 0x80;
+    mod.back() |= 1;
+    const auto base = gen(mod_size);
+
+    bytes input(3 * sizeof(intx::uint256), 0);
+    intx::be::unsafe::store(&input[0], intx::uint256{base.size()});
+    intx::be::unsafe::store(&input[32], intx::uint256{exp.size()});
+    intx::be::unsafe::store(&input[64], intx::uint256{mod.size()});
+    return input + base + exp + mod;
+}
+
+/// The 256-bit inputs as used by zk-SNARK verifiers and the EIP-198 example:
+/// inversion (x^(p-2)) and square root (x^((p+1)/4)) in prime fields.
+const std::array inputs_256{
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "1da7de8bd43f8ef6c5e2a2b25e1f63be1e44a0d7a4b5d2e1d0c5b3e9f0d1b2a3"
+    "30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd45"
+    "30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "0b1e6d35e4a7c8f2d19b3a45c6e7f80912a3b4c5d6e7f8091a2b3c4d5e6f7081"
+    "0c19139cb84c680a6e14116da060561765e05aa45a1c72a34f082305b61f3f52"
+    "30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000001"
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "0000000000000000000000000000000000000000000000000000000000000020"
+    "03"
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2e"
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f"_hex,
+};
+
+const std::array inputs_rsa2048{
+    rsa_input(256, "010001"_hex, 1),
+    rsa_input(256, "010001"_hex, 2),
+    rsa_input(256, "03"_hex, 3),
+};
+
+const std::array inputs_rsa4096{
+    rsa_input(512, "010001"_hex, 4),
+    rsa_input(512, "010001"_hex, 5),
+    rsa_input(512, "03"_hex, 6),
+};
+
+constexpr auto evmmax_cpp = expmod_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::expmod, evmmax_cpp, inputs_256);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::expmod, evmmax_cpp, inputs_rsa2048);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::expmod, evmmax_cpp, inputs_rsa4096);
+#ifdef EVMONE_PRECOMPILES_SILKPRE
+constexpr auto gmp = silkpre_expmod_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::expmod, gmp, inputs_256);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::expmod, gmp, inputs_rsa2048);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::expmod, gmp, inputs_rsa4096);
+#endif
+}  // namespace bench_expmod
+
 namespace bench_ecadd
 {
 constexpr auto evmmax_cpp = ecadd_execute;
@@ -196,30 +414,440 @@ BENCHMARK_TEMPLATE(precompile, PrecompileId::ecadd, libff);
 
 namespace bench_ecmul
 {
+/// The inputs with the full-size scalars (including the ones greater than the group order):
+/// the worst case for the scalar multiplication.
+const std::array inputs_full_scalar{
+    "0000000000000000000000000000000000000000000000000000000000000001"
+    "0000000000000000000000000000000000000000000000000000000000000002"
+    "30644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000000"_hex,
+    "0f25929bcb43d5a57391564615c9e70a992b10eafa4db109709649cf48c50dd2"
+    "16da2f5cb6be7a0aa72c440c53c9bbdfec6c36c7d515536431b3a865468acbba"
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000001"
+    "0000000000000000000000000000000000000000000000000000000000000002"
+    "2b4ad1a3a5d3e8b6f0c7e9a1d2c3b4a5968778695a4b3c2d1e0f1a2b3c4d5e6f"_hex,
+};
+
+/// The inputs with the generator G1 = (1, 2) as the base point (e.g. in the verifier contracts):
+/// these use the precomputed table of the generator multiples.
+const std::array inputs_generator{
+    "0000000000000000000000000000000000000000000000000000000000000001"
+    "0000000000000000000000000000000000000000000000000000000000000002"
+    "0fc9202d44e2bf33f6b4a67e111504852a3a7bf361194f69afa319f8423d703f"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000001"
+    "0000000000000000000000000000000000000000000000000000000000000002"
+    "2b4ad1a3a5d3e8b6f0c7e9a1d2c3b4a5968778695a4b3c2d1e0f1a2b3c4d5e6f"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000001"
+    "0000000000000000000000000000000000000000000000000000000000000002"
+    "183227397098d014dc2822db40c0ac2ecbc0b548b438e5469e10460b6c3e7ea3"_hex,
+};
+
 constexpr auto evmmax_cpp = ecmul_execute;
 BENCHMARK_TEMPLATE(precompile, PrecompileId::ecmul, evmmax_cpp);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecmul, evmmax_cpp, inputs_full_scalar);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecmul, evmmax_cpp, inputs_generator);
 #ifdef EVMONE_PRECOMPILES_SILKPRE
 constexpr auto libff = silkpre_ecmul_execute;
 BENCHMARK_TEMPLATE(precompile, PrecompileId::ecmul, libff);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecmul, libff, inputs_full_scalar);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecmul, libff, inputs_generator);
 #endif
 }  // namespace bench_ecmul
 
 namespace bench_ecpairing
 {
+/// Creates the input of the first k pairs of the concatenated Mainnet inputs.
+bytes input_k(size_t k)
+{
+    static constexpr size_t PAIR_SIZE = 192;
+    bytes pairs;
+    for (const auto& input : inputs<PrecompileId::ecpairing>)
+        pairs += input;
+    assert(pairs.size() >= k * PAIR_SIZE);
+    return pairs.substr(0, k * PAIR_SIZE);
+}
+
+const std::array inputs_k1{input_k(1)};
+const std::array inputs_k2{input_k(2)};
+const std::array inputs_k3{input_k(3)};
+const std::array inputs_k4{input_k(4)};
+const std::array inputs_k5{input_k(5)};
+const std::array inputs_k6{input_k(6)};
+const std::array inputs_k7{input_k(7)};
+const std::array inputs_k8{input_k(8)};
+
 constexpr auto evmmax_cpp = ecpairing_execute;
 BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k1);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k2);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k3);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k4);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k5);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k6);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k7);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp, inputs_k8);
 #ifdef EVMONE_PRECOMPILES_SILKPRE
 constexpr auto libff = silkpre_ecpairing_execute;
 BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, libff);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, libff, inputs_k1);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, libff, inputs_k2);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, libff, inputs_k4);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, libff, inputs_k8);
 #endif
 }  // namespace bench_ecpairing
 
+namespace bench_blake2bf
+{
+// The gas cost is the number of rounds so the gas_rate is the number of rounds per second.
+const std::array inputs_1k_rounds{blake2bf_input(1'000)};
+const std::array inputs_1m_rounds{blake2bf_input(1'000'000)};
+
+constexpr auto evmone_cpp = blake2bf_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::blake2bf, evmone_cpp);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::blake2bf, evmone_cpp, inputs_1k_rounds);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::blake2bf, evmone_cpp, inputs_1m_rounds);
+#ifdef EVMONE_PRECOMPILES_SILKPRE
+constexpr auto silkpre = silkpre_blake2bf_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::blake2bf, silkpre);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::blake2bf, silkpre, inputs_1k_rounds);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::blake2bf, silkpre, inputs_1m_rounds);
+#endif
+}  // namespace bench_blake2bf
+
 namespace bench_kzg
 {
 constexpr auto evmone_blst = point_evaluation_execute;
 BENCHMARK_TEMPLATE(precompile, PrecompileId::point_evaluation, evmone_blst);
+
+using evmone::crypto::KzgProofInput;
+
+/// The point evaluation precompile inputs as the KZG proof verification inputs.
+const auto proof_inputs = [] {
+    const auto& precompile_inputs = inputs<PrecompileId::point_evaluation>;
+    std::vector<KzgProofInput> r(precompile_inputs.size());
+    for (size_t i = 0; i < r.size(); ++i)
+    {
+        assert(precompile_inputs[i].size() == sizeof(KzgProofInput));
+        std::memcpy(&r[i], precompile_inputs[i].data(), sizeof(KzgProofInput));
+    }
+    return r;
+}();
+
+/// Verifies the proofs one by one without the cache.
+void verify_proof_uncached(benchmark::State& state)
+{
+    while (state.KeepRunningBatch(proof_inputs.size()))
+    {
+        evmone::crypto::kzg_cache_clear();
+        for (const auto& in : proof_inputs)
+        {
+            if (!evmone::crypto::kzg_verify_proof(in.versioned_hash.data(), in.z.data(),
+                    in.y.data(), in.commitment.data(), in.proof.data())) [[unlikely]]
+            {
+                state.SkipWithError("invalid result");
+                return;
+            }
+        }
+    }
+}
+BENCHMARK(verify_proof_uncached);
+
+/// Verifies the proofs with the single batch verification without the cache.
+void verify_proof_batch(benchmark::State& state)
+{
+    while (state.KeepRunningBatch(proof_inputs.size()))
+    {
+        evmone::crypto::kzg_cache_clear();
+        if (!evmone::crypto::kzg_verify_proof_batch(proof_inputs)) [[unlikely]]
+        {
+            state.SkipWithError("invalid result");
+            return;
+        }
+    }
+}
+BENCHMARK(verify_proof_batch);
 }  // namespace bench_kzg
 
+namespace bench_bls
+{
+/// Creates the pseudo-random full-size scalar.
+bytes make_scalar(uint32_t& seed)
+{
+    bytes c(32, 0);
+    for (auto& b : c)
+    {
+        seed = seed * 1103515245 + 12345;
+        b = static_cast<uint8_t>(seed >> 16);
+    }
+    return c;
+}
+
+/// Creates the multiple of the G1 generator [i]G in the precompile encoding.
+bytes g1_point(size_t i)
+{
+    const auto g =
+        "0000000000000000000000000000000017f1d3a73197d7942695638c4fa9ac0fc3688c4f9774b905a14e3a3f171bac586c55e83ff97a1aeffb3af00adb22c6bb"
+        "0000000000000000000000000000000008b3f481e3aaa0f1a09e30ed741d8ae4fcf5e095d5d00af600db18cb2c04b3edd03cc744a2888ae40caa232946c5e7e1"_hex;
+
+    uint8_t c[32]{};
+    c[30] = static_cast<uint8_t>(i >> 8);
+    c[31] = static_cast<uint8_t>(i);
+    uint8_t p[128];
+    [[maybe_unused]] const auto ok = evmone::crypto::bls::g1_mul(p, &p[64], g.data(), &g[64], c);
+    assert(ok);
+    return {p, sizeof(p)};
+}
+
+/// Creates the multiple of the G2 generator [i]G in the precompile encoding.
+bytes g2_point(size_t i)
+{
+    const auto g =
+        "00000000000000000000000000000000024aa2b2f08f0a91260805272dc51051c6e47ad4fa403b02b4510b647ae3d1770bac0326a805bbefd48056c8c121bdb8"
+        "0000000000000000000000000000000013e02b6052719f607dacd3a088274f65596bd0d09920b61ab5da61bbdc7f5049334cf11213945d57e5ac7d055d042b7e"
+        "000000000000000000000000000000000ce5d527727d6e118cc9cdc6da2e351aadfd9baa8cbdd3a76d429a695160d12c923ac9cc3baca289e193548608b82801"
+        "000000000000000000000000000000000606c4a02ea734cc32acd2b02bc28b99cb3e287e85a763af267492ab572e99ab3f370d275cec1da1aaa9075ff05f79be"_hex;
+
+    uint8_t c[32]{};
+    c[30] = static_cast<uint8_t>(i >> 8);
+    c[31] = static_cast<uint8_t>(i);
+    uint8_t p[256];
+    [[maybe_unused]] const auto ok = evmone::crypto::bls::g2_mul(p, &p[128], g.data(), &g[128], c);
+    assert(ok);
+    return {p, sizeof(p)};
+}
+
+/// Creates the pseudo-random base field element in the precompile encoding.
+bytes make_fp(uint32_t& seed)
+{
+    bytes fp(64, 0);
+    for (auto& b : std::span{fp}.subspan(16))
+    {
+        seed = seed * 1103515245 + 12345;
+        b = static_cast<uint8_t>(seed >> 16);
+    }
+    fp[16] &= 0x0f;  // Keep it below the modulus 0x1a0111ea...
+    return fp;
+}
+
+/// Creates the G1 MSM input of k pairs: the multiples of the generator [1]G, [2]G, ...
+/// and the pseudo-random scalars.
+bytes g1msm_input(size_t k)
+{
+    uint32_t seed = 1;
+    bytes input;
+    for (size_t i = 1; i <= k; ++i)
+        input += g1_point(i) + make_scalar(seed);
+    return input;
+}
+
+/// Creates the G2 MSM input of k pairs: the multiples of the generator [1]G, [2]G, ...
+/// and the pseudo-random scalars.
+bytes g2msm_input(size_t k)
+{
+    uint32_t seed = 1;
+    bytes input;
+    for (size_t i = 1; i <= k; ++i)
+        input += g2_point(i) + make_scalar(seed);
+    return input;
+}
+
+/// Creates the pairing check input of k pairs ([i]G₁, [i]G₂).
+bytes pairing_input(size_t k)
+{
+    bytes input;
+    for (size_t i = 1; i <= k; ++i)
+        input += g1_point(i) + g2_point(i);
+    return input;
+}
+
+/// Creates the map to G2 input of the pseudo-random Fp2 element.
+bytes fp2_input(uint32_t seed)
+{
+    return make_fp(seed) + make_fp(seed);
+}
+
+/// Creates the map to G1 input of the pseudo-random Fp element.
+bytes fp_input(uint32_t seed)
+{
+    return make_fp(seed);
+}
+
+// The addition of distinct points and the doubling.
+const std::array g1add_inputs{g1_point(1) + g1_point(2), g1_point(3) + g1_point(3)};
+const std::array g2add_inputs{g2_point(1) + g2_point(2), g2_point(3) + g2_point(3)};
+
+const std::array map_fp_to_g1_inputs{fp_input(1), fp_input(2), fp_input(3)};
+const std::array map_fp2_to_g2_inputs{fp2_input(1), fp2_input(2), fp2_input(3)};
+
+template <size_t K>
+const std::array pairing_inputs{pairing_input(K)};
+
+constexpr auto evmone_blst_g1add = bls12_g1add_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1add, evmone_blst_g1add, g1add_inputs);
+constexpr auto evmone_blst_g2add = bls12_g2add_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2add, evmone_blst_g2add, g2add_inputs);
+
+constexpr auto evmone_blst_map_fp = bls12_map_fp_to_g1_execute;
+BENCHMARK_TEMPLATE(
+    precompile, PrecompileId::bls12_map_fp_to_g1, evmone_blst_map_fp, map_fp_to_g1_inputs);
+constexpr auto evmone_blst_map_fp2 = bls12_map_fp2_to_g2_execute;
+BENCHMARK_TEMPLATE(
+    precompile, PrecompileId::bls12_map_fp2_to_g2, evmone_blst_map_fp2, map_fp2_to_g2_inputs);
+
+constexpr auto evmone_blst_pairing = bls12_pairing_check_execute;
+BENCHMARK_TEMPLATE(
+    precompile, PrecompileId::bls12_pairing_check, evmone_blst_pairing, pairing_inputs<1>);
+BENCHMARK_TEMPLATE(
+    precompile, PrecompileId::bls12_pairing_check, evmone_blst_pairing, pairing_inputs<2>);
+BENCHMARK_TEMPLATE(
+    precompile, PrecompileId::bls12_pairing_check, evmone_blst_pairing, pairing_inputs<4>);
+BENCHMARK_TEMPLATE(
+    precompile, PrecompileId::bls12_pairing_check, evmone_blst_pairing, pairing_inputs<8>);
+
+// The MSM inputs of the sizes from the EIP-2537 discount tables (k = 1...128).
+template <size_t K>
+const std::array g1msm_inputs{g1msm_input(K)};
+template <size_t K>
+const std::array g2msm_inputs{g2msm_input(K)};
+
+constexpr auto evmone_blst_g1 = bls12_g1msm_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<1>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<2>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<4>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<5>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<8>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<16>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<32>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<64>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<128>);
+
+constexpr auto evmone_blst_g2 = bls12_g2msm_execute;
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<1>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<2>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<4>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<5>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<8>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<16>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<32>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<64>);
+BENCHMARK_TEMPLATE(precompile, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<128>);
+
+/// The MSM computed by the given number of threads (the benchmark argument).
+template <PrecompileId Id, ExecuteFn Fn, const auto& Inputs>
+void msm_parallel(benchmark::State& state)
+{
+    evmone::crypto::bls::set_msm_parallelism(static_cast<size_t>(state.range(0)), 0);
+    precompile<Id, Fn, Inputs>(state);
+    evmone::crypto::bls::set_msm_parallelism(1);
+}
+
+BENCHMARK_TEMPLATE(msm_parallel, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<128>)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(msm_parallel, PrecompileId::bls12_g1msm, evmone_blst_g1, g1msm_inputs<512>)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(msm_parallel, PrecompileId::bls12_g2msm, evmone_blst_g2, g2msm_inputs<128>)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+}  // namespace bench_bls
+
+namespace bench_hash
+{
+/// Creates the set of count inputs of pseudo-random sizes from the [min_size, max_size] range.
+std::vector<bytes> make_inputs(size_t count, size_t min_size, size_t max_size)
+{
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    const auto next = [&seed] {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        return seed >> 33;
+    };
+
+    std::vector<bytes> inputs(count);
+    for (auto& input : inputs)
+    {
+        input.resize(min_size + next() % (max_size - min_size + 1));
+        for (auto& b : input)
+            b = static_cast<uint8_t>(next());
+    }
+    return inputs;
+}
+
+// The typical sets of inputs hashed together:
+// the 32-byte words (e.g. Merkle tree nodes), the 48-byte KZG commitments
+// (versioned hashes of blobs) and the 100–1000-byte encoded transactions or receipts.
+const auto inputs_words = make_inputs(256, 32, 32);
+const auto inputs_kzg_commitments = make_inputs(64, 48, 48);
+const auto inputs_receipts = make_inputs(64, 100, 1000);
+
+/// Benchmarks hashing the set of inputs one by one with the Fn.
+template <size_t HashSize, auto Fn, const auto& Inputs>
+void hash_loop(benchmark::State& state)
+{
+    std::vector<std::array<std::byte, HashSize>> hashes(Inputs.size());
+    size_t total_size = 0;
+    for (const auto& input : Inputs)
+        total_size += input.size();
+
+    while (state.KeepRunningBatch(Inputs.size()))
+    {
+        for (size_t i = 0; i < Inputs.size(); ++i)
+        {
+            Fn(hashes[i].data(), reinterpret_cast<const std::byte*>(Inputs[i].data()),
+                Inputs[i].size());
+        }
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_size) * state.iterations() /
+        static_cast<int64_t>(Inputs.size()));
+}
+
+/// Benchmarks hashing the set of inputs at once with the batch Fn.
+template <size_t HashSize, auto Fn, const auto& Inputs>
+void hash_batch(benchmark::State& state)
+{
+    std::vector<std::array<std::byte, HashSize>> hashes(Inputs.size());
+    std::vector<std::span<const std::byte>> input_spans;
+    size_t total_size = 0;
+    for (const auto& input : Inputs)
+    {
+        input_spans.emplace_back(reinterpret_cast<const std::byte*>(input.data()), input.size());
+        total_size += input.size();
+    }
+
+    while (state.KeepRunningBatch(Inputs.size()))
+    {
+        Fn(reinterpret_cast<std::byte(*)[HashSize]>(hashes.data()), input_spans);
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_size) * state.iterations() /
+        static_cast<int64_t>(Inputs.size()));
+}
+
+using evmone::crypto::RIPEMD160_HASH_SIZE;
+using evmone::crypto::SHA256_HASH_SIZE;
+constexpr auto sha256 = evmone::crypto::sha256;
+constexpr auto sha256_batch = evmone::crypto::sha256_batch;
+constexpr auto ripemd160 = evmone::crypto::ripemd160;
+constexpr auto ripemd160_batch = evmone::crypto::ripemd160_batch;
+
+BENCHMARK_TEMPLATE(hash_loop, SHA256_HASH_SIZE, sha256, inputs_words);
+BENCHMARK_TEMPLATE(hash_batch, SHA256_HASH_SIZE, sha256_batch, inputs_words);
+BENCHMARK_TEMPLATE(hash_loop, SHA256_HASH_SIZE, sha256, inputs_kzg_commitments);
+BENCHMARK_TEMPLATE(hash_batch, SHA256_HASH_SIZE, sha256_batch, inputs_kzg_commitments);
+BENCHMARK_TEMPLATE(hash_loop, SHA256_HASH_SIZE, sha256, inputs_receipts);
+BENCHMARK_TEMPLATE(hash_batch, SHA256_HASH_SIZE, sha256_batch, inputs_receipts);
+BENCHMARK_TEMPLATE(hash_loop, RIPEMD160_HASH_SIZE, ripemd160, inputs_words);
+BENCHMARK_TEMPLATE(hash_batch, RIPEMD160_HASH_SIZE, ripemd160_batch, inputs_words);
+BENCHMARK_TEMPLATE(hash_loop, RIPEMD160_HASH_SIZE, ripemd160, inputs_kzg_commitments);
+BENCHMARK_TEMPLATE(hash_batch, RIPEMD160_HASH_SIZE, ripemd160_batch, inputs_kzg_commitments);
+BENCHMARK_TEMPLATE(hash_loop, RIPEMD160_HASH_SIZE, ripemd160, inputs_receipts);
+BENCHMARK_TEMPLATE(hash_batch, RIPEMD160_HASH_SIZE, ripemd160_batch, inputs_receipts);
+}  // namespace bench_hash
+
 }  // namespace
 
 BENCHMARK_MAIN();
@@ -0,0 +1,178 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace evmone::state
+{
+/// Cheap hash of fixed-size byte keys like addresses and storage keys.
+///
+/// Most of the keys are already random (Keccak outputs) so it is enough to fold the key words
+/// together. The keys can also be small integers (e.g. Solidity fixed storage slots) which
+/// only have the last bytes non-zero. Therefore, the folded value is mixed with
+/// the Fibonacci multiplier and the high bits of the result should be used as the table index.
+struct FlatKeyHash
+{
+    template <typename T>
+    uint64_t operator()(const T& key) const noexcept
+    {
+        static constexpr auto size = sizeof(key.bytes);
+        static_assert(size % 4 == 0);
+
+        uint64_t h = 0;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t w = 0;
+            std::memcpy(&w, &key.bytes[i], sizeof(w));
+            h = std::rotl(h, 23) ^ w;
+        }
+        if (i != size)
+        {
+            uint32_t w = 0;
+            std::memcpy(&w, &key.bytes[i], sizeof(w));
+            h = std::rotl(h, 23) ^ w;
+        }
+        h ^= h >> 29;
+        return h * 0x9e3779b97f4a7c15;
+    }
+};
+
+/// The associative container with open addressing for small trivially-copyable keys.
+///
+/// The entries are kept densely in insertion order and the separate index table
+/// (linear probing, power-of-two size, load factor at most 1/2) maps key hashes
+/// to the positions of entries. Compared to std::unordered_map this does not allocate per entry
+/// and the iteration order is deterministic.
+///
+/// Erasing of individual entries is not supported. References to entries are invalidated
+/// by insertions, as in std::vector.
+template <typename Key, typename Value, typename Hash = FlatKeyHash>
+class FlatMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+    /// The marker of an empty slot in the index table.
+    static constexpr auto EMPTY = std::numeric_limits<uint32_t>::max();
+
+    /// The minimal non-zero size of the index table.
+    static constexpr size_t MIN_INDEX_SIZE = 8;
+
+    /// The entries in insertion order.
+    std::vector<value_type> m_entries;
+
+    /// The index table: positions of entries in m_entries or EMPTY.
+    std::vector<uint32_t> m_index;
+
+    /// The shift applied to the hash to get the index table slot: 64 - log2(m_index.size()).
+    int m_shift = 64;
+
+    /// Finds the index table slot holding the key or the empty slot where the key can be inserted.
+    /// The index table must not be empty.
+    [[nodiscard]] size_t find_slot(const Key& key) const noexcept
+    {
+        assert(!m_index.empty());
+        const auto mask = m_index.size() - 1;
+        auto slot = static_cast<size_t>(Hash{}(key) >> m_shift);
+        while (true)
+        {
+            const auto pos = m_index[slot];
+            if (pos == EMPTY || m_entries[pos].first == key)
+                return slot;
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    /// Returns the position of the entry with the key or EMPTY if not present.
+    [[nodiscard]] uint32_t find_pos(const Key& key) const noexcept
+    {
+        return !m_index.empty() ? m_index[find_slot(key)] : EMPTY;
+    }
+
+    /// Rebuilds the index table with the given size (power of 2).
+    void rehash(size_t index_size)
+    {
+        assert(std::has_single_bit(index_size));
+        m_index.assign(index_size, EMPTY);
+        m_shift = 64 - std::countr_zero(index_size);
+        for (size_t i = 0; i < m_entries.size(); ++i)
+            m_index[find_slot(m_entries[i].first)] = static_cast<uint32_t>(i);
+    }
+
+public:
+    FlatMap() noexcept = default;
+
+    [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+
+    [[nodiscard]] iterator begin() noexcept { return m_entries.begin(); }
+    [[nodiscard]] iterator end() noexcept { return m_entries.end(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return m_entries.begin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return m_entries.end(); }
+
+    /// Reserves space for at least the given number of entries without rehashing.
+    void reserve(size_t n)
+    {
+        m_entries.reserve(n);
+        if (const auto index_size = std::bit_ceil(std::max(n * 2, MIN_INDEX_SIZE));
+            index_size > m_index.size())
+            rehash(index_size);
+    }
+
+    void clear() noexcept
+    {
+        m_entries.clear();
+        m_index.clear();
+        m_shift = 64;
+    }
+
+    [[nodiscard]] iterator find(const Key& key) noexcept
+    {
+        const auto pos = find_pos(key);
+        return pos != EMPTY ? m_entries.begin() + pos : end();
+    }
+
+    [[nodiscard]] const_iterator find(const Key& key) const noexcept
+    {
+        const auto pos = find_pos(key);
+        return pos != EMPTY ? m_entries.begin() + pos : end();
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const noexcept { return find(key) != end(); }
+
+    /// Inserts the value-initialized entry for the key if the key is not present.
+    /// @return The iterator to the entry and the flag if the entry has been inserted.
+    std::pair<iterator, bool> try_emplace(const Key& key)
+    {
+        // Keep the load factor at most 1/2.
+        if ((m_entries.size() + 1) * 2 > m_index.size())
+            rehash(std::max(m_index.size() * 2, MIN_INDEX_SIZE));
+
+        const auto slot = find_slot(key);
+        if (const auto pos = m_index[slot]; pos != EMPTY)
+            return {m_entries.begin() + pos, false};
+
+        assert(m_entries.size() < EMPTY);
+        m_index[slot] = static_cast<uint32_t>(m_entries.size());
+        m_entries.emplace_back(key, Value{});
+        return {m_entries.end() - 1, true};
+    }
+
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+};
+}  // namespace evmone::state
@@ -6,6 +6,7 @@
 #include "precompiles.hpp"
 #include <evmone/constants.hpp>
 #include <evmone/eof.hpp>
+#include <new>
 
 namespace evmone::state
 {
@@ -17,7 +18,7 @@ bool Host::account_exists(const address& addr) const noexcept
 
 bytes32 Host::get_storage(const address& addr, const bytes32& key) const noexcept
 {
-    return m_state.get_storage(addr, key).current;
+    return m_state.get_storage(get_account(addr), addr, key).current;
 }
 
 evmc_storage_status Host::set_storage(
@@ -26,7 +27,7 @@ evmc_storage_status Host::set_storage(
     // Follow EVMC documentation https://evmc.ethereum.org/storagestatus.html#autotoc_md3
     // and EIP-2200 specification https://eips.ethereum.org/EIPS/eip-2200.
 
-    auto& storage_slot = m_state.get_storage(addr, key);
+    auto& storage_slot = m_state.get_storage(get_account(addr), addr, key);
     const auto& [current, original, _] = storage_slot;
 
     const auto dirty = original != current;
@@ -349,7 +350,7 @@ evmc::Result Host::create(const evmc_message& msg) noexcept
         create_msg.input_size = 0;
     }
 
-    auto result = m_vm.execute(*this, m_rev, create_msg, initcode.data(), initcode.size());
+    auto result = execute_code(create_msg, new_acc, initcode);
     if (result.status_code != EVMC_SUCCESS)
     {
         result.create_address = msg.recipient;
@@ -442,14 +443,39 @@ evmc::Result Host::execute_message(const evmc_message& msg) noexcept
 
     // Calls to precompile address via EIP-7702 delegation execute empty code instead of precompile.
     if ((msg.flags & EVMC_DELEGATED) == 0 && is_precompile(m_rev, msg.code_address))
-        return call_precompile(m_rev, msg);
+    {
+        const auto depth = static_cast<size_t>(msg.depth);
+        if (depth >= m_precompile_outputs.size())
+        {
+            try
+            {
+                m_precompile_outputs.resize(depth + 1);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return evmc::Result{EVMC_OUT_OF_MEMORY};
+            }
+        }
+        return call_precompile(m_rev, msg, m_precompile_outputs[depth]);
+    }
 
     // TODO: get_code() performs the account lookup. Add a way to get an account with code?
     const auto code = m_state.get_code(msg.code_address);
     if (code.empty())
         return evmc::Result{EVMC_SUCCESS, msg.gas};  // Skip trivial execution.
 
-    return m_vm.execute(*this, m_rev, msg, code.data(), code.size());
+    return execute_code(msg, m_state.find(msg.recipient), code);
+}
+
+evmc::Result Host::execute_code(
+    const evmc_message& msg, Account* recipient_acc, bytes_view code) noexcept
+{
+    // The recipient account cannot be erased during the execution of this frame:
+    // the rollbacks in nested calls only revert the changes made after the frame started.
+    const auto parent_recipient = std::exchange(m_recipient, {msg.recipient, recipient_acc});
+    auto result = m_vm.execute(*this, m_rev, msg, code.data(), code.size());
+    m_recipient = parent_recipient;
+    return result;
 }
 
 evmc::Result Host::call(const evmc_message& orig_msg) noexcept
@@ -533,7 +559,7 @@ evmc_access_status Host::access_account(const address& addr) noexcept
 
 evmc_access_status Host::access_storage(const address& addr, const bytes32& key) noexcept
 {
-    auto& storage_slot = m_state.get_storage(addr, key);
+    auto& storage_slot = m_state.get_storage(get_account(addr), addr, key);
     m_state.journal_storage_change(addr, key, storage_slot);
     return std::exchange(storage_slot.access_status, EVMC_ACCESS_WARM);
 }
@@ -541,7 +567,7 @@ evmc_access_status Host::access_storage(const address& addr, const bytes32& key)
 
 evmc::bytes32 Host::get_transient_storage(const address& addr, const bytes32& key) const noexcept
 {
-    const auto& acc = m_state.get(addr);
+    const auto& acc = get_account(addr);
     const auto it = acc.transient_storage.find(key);
     return it != acc.transient_storage.end() ? it->second : bytes32{};
 }
@@ -549,7 +575,7 @@ evmc::bytes32 Host::get_transient_storage(const address& addr, const bytes32& ke
 void Host::set_transient_storage(
     const address& addr, const bytes32& key, const bytes32& value) noexcept
 {
-    auto& slot = m_state.get(addr).transient_storage[key];
+    auto& slot = get_account(addr).transient_storage[key];
     m_state.journal_transient_storage_change(addr, key, slot);
     slot = value;
 }
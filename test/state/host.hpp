@@ -44,6 +44,24 @@ class Host : public evmc::Host
     const Transaction& m_tx;
     std::vector<Log> m_logs;
 
+    /// The handle to the account of the recipient of the currently executing message.
+    ///
+    /// The storage instructions access the storage of the executing contract,
+    /// so the account is looked up once per execution frame and the storage access methods
+    /// use it directly instead of repeating the lookup by address.
+    struct AccountHandle
+    {
+        address addr;
+        Account* acc = nullptr;
+    } m_recipient;
+
+    /// The reusable output buffers of precompile calls, by the call depth.
+    ///
+    /// The precompile output is written directly to the buffer of the call's depth
+    /// and the result only references it (no allocation or release callback per call).
+    /// The caller consumes the output before it makes another call at the same depth.
+    std::vector<bytes> m_precompile_outputs;
+
 public:
     Host(evmc_revision rev, evmc::VM& vm, State& state, const BlockInfo& block,
         const BlockHashes& block_hashes, const Transaction& tx) noexcept
@@ -104,5 +122,19 @@ private:
     std::optional<evmc_message> prepare_message(evmc_message msg) noexcept;
 
     evmc::Result execute_message(const evmc_message& msg) noexcept;
+
+    /// Executes the code in the VM with the recipient account handle set for the execution frame.
+    /// The handle of the parent frame is restored afterwards.
+    evmc::Result execute_code(
+        const evmc_message& msg, Account* recipient_acc, bytes_view code) noexcept;
+
+    /// Gets the account at the address (the account must exist).
+    /// Skips the lookup if the address is the recipient of the currently executing message.
+    [[nodiscard]] Account& get_account(const address& addr) const noexcept
+    {
+        if (m_recipient.acc != nullptr && addr == m_recipient.addr)
+            return *m_recipient.acc;
+        return m_state.get(addr);
+    }
 };
 }  // namespace evmone::state
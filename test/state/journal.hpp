@@ -0,0 +1,94 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace evmone::state
+{
+/// The journal of state changes: the byte-packed sequence of type-tagged entries.
+///
+/// Each entry is stored as its object representation followed by the one-byte type tag.
+/// Therefore, every entry only takes as much space as its own type requires
+/// (in contrast to std::variant sized by the largest alternative)
+/// and the journal can be walked backwards by reading the tag at the end of each entry.
+///
+/// The checkpoints are the byte offsets in the journal.
+template <typename... Entries>
+class Journal
+{
+    static_assert(sizeof...(Entries) <= 256);
+    static_assert((std::is_trivially_copyable_v<Entries> && ...));
+
+    /// The sizes of the entries by the type tag.
+    static constexpr std::array<size_t, sizeof...(Entries)> ENTRY_SIZES{sizeof(Entries)...};
+
+    /// The type tag of the entry type T: the index of T in the Entries list.
+    template <typename T>
+    static constexpr auto TAG_OF = [] {
+        uint8_t tag = 0;
+        [[maybe_unused]] const auto found = ((std::is_same_v<T, Entries> || (++tag, false)) || ...);
+        assert(found);
+        return tag;
+    }();
+
+    /// The packed entries.
+    std::pmr::vector<uint8_t> m_data;
+
+    template <typename T>
+    [[nodiscard]] static T load(const uint8_t* p) noexcept
+    {
+        T e;
+        std::memcpy(&e, p, sizeof(e));
+        return e;
+    }
+
+public:
+    explicit Journal(std::pmr::memory_resource* memory = std::pmr::get_default_resource()) noexcept
+      : m_data{memory}
+    {}
+
+    /// Returns the size of the journal in bytes. This is the current checkpoint.
+    [[nodiscard]] size_t size() const noexcept { return m_data.size(); }
+
+    /// Appends the entry at the end of the journal.
+    template <typename T>
+    void push(const T& e)
+    {
+        static constexpr auto tag = TAG_OF<T>;
+        const auto pos = m_data.size();
+        m_data.resize(pos + sizeof(e) + 1);
+        std::memcpy(&m_data[pos], &e, sizeof(e));
+        m_data[pos + sizeof(e)] = tag;
+    }
+
+    /// Removes the entries newer than the checkpoint, from the newest to the oldest.
+    ///
+    /// The @p undo is called with every removed entry (decoded to its type).
+    template <typename F>
+    void rollback(size_t checkpoint, F&& undo)
+    {
+        assert(checkpoint <= m_data.size());
+        auto end = m_data.size();
+        while (end != checkpoint)
+        {
+            const auto tag = m_data[end - 1];
+            assert(tag < ENTRY_SIZES.size());
+            const auto begin = end - 1 - ENTRY_SIZES[tag];
+            const auto* const p = &m_data[begin];
+            [[maybe_unused]] const auto visited =
+                ((tag == TAG_OF<Entries> && (undo(load<Entries>(p)), true)) || ...);
+            assert(visited);
+            end = begin;
+        }
+        m_data.resize(checkpoint);
+    }
+};
+}  // namespace evmone::state
@@ -3,21 +3,28 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "precompiles.hpp"
+#include "hash_utils.hpp"
 #include "precompiles_internal.hpp"
-#include "precompiles_stubs.hpp"
 #include <evmone_precompiles/blake2b.hpp>
 #include <evmone_precompiles/bls.hpp>
 #include <evmone_precompiles/bn254.hpp>
 #include <evmone_precompiles/kzg.hpp>
+#include <evmone_precompiles/modexp.hpp>
 #include <evmone_precompiles/ripemd160.hpp>
 #include <evmone_precompiles/secp256k1.hpp>
 #include <evmone_precompiles/sha256.hpp>
 #include <intx/intx.hpp>
 #include <array>
+#include <atomic>
 #include <bit>
 #include <cassert>
+#include <cstring>
 #include <limits>
+#include <list>
+#include <mutex>
+#include <new>
 #include <span>
+#include <unordered_map>
 
 #ifdef EVMONE_PRECOMPILES_SILKPRE
 #include "precompiles_silkpre.hpp"
@@ -130,9 +137,10 @@ PrecompileAnalysis expmod_analyze(bytes_view input, evmc_revision rev) noexcept
                     static_cast<size_t>(std::bit_width(head_explicit_bytes[top_byte_index])) :
                 0;
 
-        return std::max(
-            8 * (std::max(len, size_t{32}) - 32) + (std::max(exp_bit_width, size_t{1}) - 1),
-            size_t{1});
+        // Computed in uint256 because it can overflow size_t for the huge len.
+        return std::max(8 * (uint256{std::max(len, size_t{32})} - 32) +
+                            (std::max(exp_bit_width, size_t{1}) - 1),
+            uint256{1});
     };
 
     static constexpr auto mult_complexity_eip2565 = [](const uint256& x) noexcept {
@@ -405,6 +413,56 @@ ExecutionResult identity_execute(const uint8_t* input, size_t input_size, uint8_
     return {EVMC_SUCCESS, input_size};
 }
 
+ExecutionResult expmod_execute(
+    const uint8_t* input, size_t input_size, uint8_t* output, size_t output_size) noexcept
+{
+    static constexpr auto LEN_SIZE = sizeof(intx::uint256);
+    static constexpr auto HEADER_SIZE = 3 * LEN_SIZE;
+
+    // The output size equal to the modulus size.
+    const auto mod_len = output_size;
+    if (mod_len == 0)
+        return {EVMC_SUCCESS, 0};
+
+    uint8_t header[HEADER_SIZE]{};
+    std::copy_n(input, std::min(input_size, HEADER_SIZE), header);
+    // The lengths fit size_t, otherwise the gas cost would be infinite.
+    const auto base_len = static_cast<size_t>(intx::be::unsafe::load<intx::uint256>(&header[0]));
+    const auto exp_len =
+        static_cast<size_t>(intx::be::unsafe::load<intx::uint256>(&header[LEN_SIZE]));
+    assert(intx::be::unsafe::load<intx::uint256>(&header[2 * LEN_SIZE]) == mod_len);
+
+    // The missing input bytes are zeros. If the modulus is missing entirely the result is 0.
+    // Otherwise, only the modulus can be truncated and it is copied to the zero-padded buffer.
+    bytes_view payload{input, input_size};
+    payload.remove_prefix(std::min(input_size, HEADER_SIZE));
+    if (base_len >= payload.size() || exp_len >= payload.size() - base_len)
+    {
+        std::fill_n(output, mod_len, uint8_t{0});
+        return {EVMC_SUCCESS, mod_len};
+    }
+    const auto base = payload.substr(0, base_len);
+    const auto exp = payload.substr(base_len, exp_len);
+    auto mod = payload.substr(base_len + exp_len, mod_len);
+    try
+    {
+        bytes padded_mod;
+        if (mod.size() < mod_len)
+        {
+            padded_mod.resize(mod_len);
+            std::ranges::copy(mod, padded_mod.begin());
+            mod = padded_mod;
+        }
+
+        crypto::modexp(output, base, exp, mod);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return {EVMC_OUT_OF_MEMORY, 0};
+    }
+    return {EVMC_SUCCESS, mod_len};
+}
+
 ExecutionResult blake2bf_execute(const uint8_t* input, [[maybe_unused]] size_t input_size,
     uint8_t* output, [[maybe_unused]] size_t output_size) noexcept
 {
@@ -564,6 +622,9 @@ struct PrecompileTraits
 {
     decltype(identity_analyze)* analyze = nullptr;
     decltype(identity_execute)* execute = nullptr;
+
+    /// Whether the results are memoized (only for the expensive precompiles).
+    bool memoize = false;
 };
 
 inline constexpr auto traits = []() noexcept {
@@ -573,17 +634,17 @@ inline constexpr auto traits = []() noexcept {
         {sha256_analyze, sha256_execute},
         {ripemd160_analyze, ripemd160_execute},
         {identity_analyze, identity_execute},
-        {expmod_analyze, expmod_stub},
+        {expmod_analyze, expmod_execute, true},
         {ecadd_analyze, ecadd_execute},
         {ecmul_analyze, ecmul_execute},
-        {ecpairing_analyze, ecpairing_execute},
+        {ecpairing_analyze, ecpairing_execute, true},
         {blake2bf_analyze, blake2bf_execute},
-        {point_evaluation_analyze, point_evaluation_execute},
+        {point_evaluation_analyze, point_evaluation_execute, true},
         {bls12_g1add_analyze, bls12_g1add_execute},
-        {bls12_g1msm_analyze, bls12_g1msm_execute},
+        {bls12_g1msm_analyze, bls12_g1msm_execute, true},
         {bls12_g2add_analyze, bls12_g2add_execute},
-        {bls12_g2msm_analyze, bls12_g2msm_execute},
-        {bls12_pairing_check_analyze, bls12_pairing_check_execute},
+        {bls12_g2msm_analyze, bls12_g2msm_execute, true},
+        {bls12_pairing_check_analyze, bls12_pairing_check_execute, true},
         {bls12_map_fp_to_g1_analyze, bls12_map_fp_to_g1_execute},
         {bls12_map_fp2_to_g2_analyze, bls12_map_fp2_to_g2_execute},
     }};
@@ -627,27 +688,267 @@ bool is_precompile(evmc_revision rev, const evmc::address& addr) noexcept
     return true;
 }
 
-evmc::Result call_precompile(evmc_revision rev, const evmc_message& msg) noexcept
+namespace
+{
+/// The process-wide memo of the precompile results with the memory limit and LRU eviction.
+class PrecompileMemo
+{
+public:
+    struct Key
+    {
+        uint8_t id = 0;
+        evmc_revision rev = EVMC_FRONTIER;
+        hash256 input_hash;
+
+        bool operator==(const Key&) const = default;
+    };
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const noexcept
+        {
+            // The input hash is already random.
+            uint64_t h = 0;
+            std::memcpy(&h, key.input_hash.bytes, sizeof(h));
+            return static_cast<size_t>(h ^ (uint64_t{key.id} << 8) ^ uint64_t{key.rev});
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        evmc_status_code status_code = EVMC_SUCCESS;
+        bytes output;
+
+        /// The approximate memory usage of the entry, including the containers' overhead.
+        [[nodiscard]] size_t memory() const noexcept
+        {
+            static constexpr size_t CONTAINERS_OVERHEAD = 64;
+            return sizeof(Entry) + output.size() + CONTAINERS_OVERHEAD;
+        }
+    };
+
+    /// The memory limit. Checked without locking to keep the disabled memo free.
+    std::atomic<size_t> m_limit = 0;
+
+    std::mutex m_mutex;
+
+    /// The entries from the most recently used to the least recently used.
+    std::list<Entry> m_lru;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+    size_t m_memory = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+
+    /// Evicts the least recently used entries until the memory usage is within the limit.
+    void evict(size_t limit) noexcept
+    {
+        while (m_memory > limit)
+        {
+            const auto& e = m_lru.back();
+            m_memory -= e.memory();
+            m_index.erase(e.key);
+            m_lru.pop_back();
+            ++m_evictions;
+        }
+    }
+
+public:
+    [[nodiscard]] bool enabled() const noexcept
+    {
+        return m_limit.load(std::memory_order_relaxed) != 0;
+    }
+
+    void set_limit(size_t max_memory) noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        m_limit.store(max_memory, std::memory_order_relaxed);
+        evict(max_memory);
+    }
+
+    /// Looks up the result and copies its output to the @p output buffer.
+    std::optional<ExecutionResult> find(
+        const Key& key, uint8_t* output, size_t max_output_size) noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        const auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            ++m_misses;
+            return std::nullopt;
+        }
+        ++m_hits;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        const auto& e = *it->second;
+        assert(e.output.size() <= max_output_size);
+        std::copy_n(e.output.data(), std::min(e.output.size(), max_output_size), output);
+        return ExecutionResult{e.status_code, e.output.size()};
+    }
+
+    /// Inserts the result. The result is not memoized if the entry cannot be allocated.
+    void insert(const Key& key, ExecutionResult result, const uint8_t* output) noexcept
+    {
+        try
+        {
+            Entry entry{key, result.status_code, bytes{output, result.output_size}};
+            const auto entry_memory = entry.memory();
+
+            const std::lock_guard lock{m_mutex};
+            const auto limit = m_limit.load(std::memory_order_relaxed);
+            if (entry_memory > limit || m_index.contains(key))
+                return;
+
+            evict(limit - entry_memory);
+            m_lru.push_front(std::move(entry));
+            try
+            {
+                m_index.emplace(key, m_lru.begin());
+            }
+            catch (const std::bad_alloc&)
+            {
+                m_lru.pop_front();
+                throw;
+            }
+            m_memory += entry_memory;
+        }
+        catch (const std::bad_alloc&)
+        {
+            // Skip memoizing. The memo is only an optimization.
+        }
+    }
+
+    PrecompileMemoStats stats() noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        return {m_hits, m_misses, m_evictions, m_lru.size(), m_memory};
+    }
+
+    void clear() noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        m_index.clear();
+        m_lru.clear();
+        m_memory = 0;
+        m_hits = 0;
+        m_misses = 0;
+        m_evictions = 0;
+    }
+};
+
+PrecompileMemo& precompile_memo() noexcept
+{
+    static PrecompileMemo memo;
+    return memo;
+}
+
+/// Executes the precompile using the memoized result if available.
+ExecutionResult execute_memoized(decltype(identity_execute)* execute, uint8_t id,
+    evmc_revision rev, bytes_view input, uint8_t* output, size_t max_output_size) noexcept
+{
+    auto& memo = precompile_memo();
+    if (!memo.enabled())
+        return execute(input.data(), input.size(), output, max_output_size);
+
+    const PrecompileMemo::Key key{id, rev, keccak256(input)};
+    if (const auto r = memo.find(key, output, max_output_size))
+        return *r;
+
+    const auto r = execute(input.data(), input.size(), output, max_output_size);
+    // The allocation failure is not the property of the input so it is not memoized.
+    if (r.status_code != EVMC_OUT_OF_MEMORY)
+        memo.insert(key, r, output);
+    return r;
+}
+
+/// Analyzes and executes the precompile.
+/// The output is written to the buffer returned by @p get_output_buffer(max_output_size).
+/// The null buffer reports the allocation failure.
+/// If @p reference_input is set, the output of the identity precompile references the input
+/// instead (no copy).
+/// @return The result without the release callback set.
+template <typename GetOutputBufferFn>
+evmc_result execute_precompile(evmc_revision rev, const evmc_message& msg,
+    GetOutputBufferFn get_output_buffer, bool reference_input) noexcept
 {
     assert(msg.gas >= 0);
 
     const auto id = msg.code_address.bytes[19];
-    const auto [analyze, execute] = traits[id];
+    const auto [analyze, execute, memoize] = traits[id];
 
     const bytes_view input{msg.input_data, msg.input_size};
     const auto [gas_cost, max_output_size] = analyze(input, rev);
     const auto gas_left = msg.gas - gas_cost;
     if (gas_left < 0)
-        return evmc::Result{EVMC_OUT_OF_GAS};
+        return evmc_result{.status_code = EVMC_OUT_OF_GAS};
+
+    if (reference_input && id == stdx::to_underlying(PrecompileId::identity))
+    {
+        return evmc_result{.status_code = EVMC_SUCCESS,
+            .gas_left = gas_left,
+            .output_data = msg.input_data,
+            .output_size = msg.input_size};
+    }
+
+    auto* const output_data = get_output_buffer(max_output_size);
+    if (output_data == nullptr) [[unlikely]]
+        return evmc_result{.status_code = EVMC_OUT_OF_MEMORY};
+
+    const auto [status_code, output_size] =
+        memoize ? execute_memoized(execute, id, rev, input, output_data, max_output_size) :
+                  execute(msg.input_data, msg.input_size, output_data, max_output_size);
+    return evmc_result{.status_code = status_code,
+        .gas_left = status_code == EVMC_SUCCESS ? gas_left : 0,
+        .output_data = output_data,
+        .output_size = output_size};
+}
+}  // namespace
 
+evmc::Result call_precompile(evmc_revision rev, const evmc_message& msg) noexcept
+{
     // Allocate buffer for the precompile's output and pass its ownership to evmc::Result.
     // TODO: This can be done more elegantly by providing constructor evmc::Result(std::unique_ptr).
-    const auto output_data = new (std::nothrow) uint8_t[max_output_size];
-    const auto [status_code, output_size] =
-        execute(msg.input_data, msg.input_size, output_data, max_output_size);
-    const evmc_result result{status_code, status_code == EVMC_SUCCESS ? gas_left : 0, 0,
-        output_data, output_size,
-        [](const evmc_result* res) noexcept { delete[] res->output_data; }};
+    auto result = execute_precompile(
+        rev, msg,
+        [](size_t max_output_size) noexcept { return new (std::nothrow) uint8_t[max_output_size]; },
+        false);
+    if (result.output_data != nullptr)
+        result.release = [](const evmc_result* res) noexcept { delete[] res->output_data; };
     return evmc::Result{result};
 }
+
+evmc::Result call_precompile(
+    evmc_revision rev, const evmc_message& msg, bytes& output_buffer) noexcept
+{
+    return evmc::Result{execute_precompile(
+        rev, msg,
+        [&output_buffer](size_t max_output_size) noexcept -> uint8_t* {
+            try
+            {
+                output_buffer.resize(max_output_size);
+                return output_buffer.data();
+            }
+            catch (const std::bad_alloc&)
+            {
+                return nullptr;
+            }
+        },
+        true)};
+}
+
+void set_precompile_memo_limit(size_t max_memory) noexcept
+{
+    precompile_memo().set_limit(max_memory);
+}
+
+PrecompileMemoStats precompile_memo_stats() noexcept
+{
+    return precompile_memo().stats();
+}
+
+void precompile_memo_clear() noexcept
+{
+    precompile_memo().clear();
+}
 }  // namespace evmone::state
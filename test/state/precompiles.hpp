@@ -5,6 +5,7 @@
 
 #include "../utils/stdx/utility.hpp"
 #include <evmc/evmc.hpp>
+#include <cstdint>
 #include <optional>
 
 namespace evmone::state
@@ -45,4 +46,50 @@ bool is_precompile(evmc_revision rev, const evmc::address& addr) noexcept;
 
 /// Executes the message to a precompiled contract (msg.code_address must be a precompile).
 evmc::Result call_precompile(evmc_revision rev, const evmc_message& msg) noexcept;
+
+/// Executes the message to a precompiled contract (msg.code_address must be a precompile)
+/// writing the output directly to the provided @p output_buffer.
+///
+/// The buffer is resized to fit the output so its capacity is reused between calls.
+/// If the resize fails, the result has the EVMC_OUT_OF_MEMORY status.
+/// The result has no release callback and references the buffer, therefore the buffer
+/// must not be modified or destroyed until the output of the result is consumed.
+/// The output of the identity precompile references the message input instead (zero-copy)
+/// so the same applies to the input and the output may overlap with the caller's memory.
+evmc::Result call_precompile(
+    evmc_revision rev, const evmc_message& msg, evmc::bytes& output_buffer) noexcept;
+
+/// The statistics of the precompile results memo.
+struct PrecompileMemoStats
+{
+    uint64_t hits = 0;       ///< The number of calls served from the memo.
+    uint64_t misses = 0;     ///< The number of calls executed and memoized.
+    uint64_t evictions = 0;  ///< The number of results evicted to fit the memory limit.
+    size_t size = 0;         ///< The current number of memoized results.
+    size_t memory = 0;       ///< The current approximate memory usage in bytes.
+
+    /// The fraction of memoizable calls served from the memo.
+    [[nodiscard]] double hit_rate() const noexcept
+    {
+        const auto lookups = hits + misses;
+        return lookups != 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+/// Sets the memory limit (in bytes) of the process-wide memo of the precompile results.
+///
+/// The results of the expensive pure precompiles (expmod, ecpairing, point evaluation,
+/// BLS MSMs and pairing check) are memoized by the precompile id, the revision
+/// and the Keccak-256 hash of the input. This speeds up re-executions of the same block
+/// (e.g. reorgs, tracing, validating the just built block).
+/// When the limit is exceeded the least recently used results are evicted.
+/// The memo is disabled by default (the limit 0).
+void set_precompile_memo_limit(size_t max_memory) noexcept;
+
+/// Returns the statistics of the precompile results memo.
+PrecompileMemoStats precompile_memo_stats() noexcept;
+
+/// Removes all the precompile results from the memo and resets the statistics.
+/// The memory limit is not changed.
+void precompile_memo_clear() noexcept;
 }  // namespace evmone::state
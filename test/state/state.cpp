@@ -299,15 +299,18 @@ Account& State::touch(const address& addr)
     if (!acc.erase_if_empty && acc.is_empty())
     {
         acc.erase_if_empty = true;
-        m_journal.emplace_back(JournalTouched{addr});
+        m_journal.push(JournalTouched{addr});
     }
     return acc;
 }
 
 StorageValue& State::get_storage(const address& addr, const bytes32& key)
 {
-    // TODO: Avoid account lookup by giving the reference to the account's storage to Host.
-    auto& acc = get(addr);
+    return get_storage(get(addr), addr, key);
+}
+
+StorageValue& State::get_storage(Account& acc, const address& addr, const bytes32& key)
+{
     const auto [it, missing] = acc.storage.try_emplace(key);
     if (missing)
     {
@@ -319,107 +322,101 @@ StorageValue& State::get_storage(const address& addr, const bytes32& key)
 
 void State::journal_balance_change(const address& addr, const intx::uint256& prev_balance)
 {
-    m_journal.emplace_back(JournalBalanceChange{{addr}, prev_balance});
+    m_journal.push(JournalBalanceChange{{addr}, prev_balance});
 }
 
 void State::journal_storage_change(
     const address& addr, const bytes32& key, const StorageValue& value)
 {
-    m_journal.emplace_back(JournalStorageChange{{addr}, key, value.current, value.access_status});
+    m_journal.push(JournalStorageChange{{addr}, key, value.current, value.access_status});
 }
 
 void State::journal_transient_storage_change(
     const address& addr, const bytes32& key, const bytes32& value)
 {
-    m_journal.emplace_back(JournalTransientStorageChange{{addr}, key, value});
+    m_journal.push(JournalTransientStorageChange{{addr}, key, value});
 }
 
 void State::journal_bump_nonce(const address& addr)
 {
-    m_journal.emplace_back(JournalNonceBump{addr});
+    m_journal.push(JournalNonceBump{addr});
 }
 
 void State::journal_create(const address& addr, bool existed)
 {
-    m_journal.emplace_back(JournalCreate{{addr}, existed});
+    m_journal.push(JournalCreate{{addr}, existed});
 }
 
 void State::journal_destruct(const address& addr)
 {
-    m_journal.emplace_back(JournalDestruct{addr});
+    m_journal.push(JournalDestruct{addr});
 }
 
 void State::journal_access_account(const address& addr)
 {
-    m_journal.emplace_back(JournalAccessAccount{addr});
+    m_journal.push(JournalAccessAccount{addr});
 }
 
 void State::rollback(size_t checkpoint)
 {
-    while (m_journal.size() != checkpoint)
-    {
-        std::visit(
-            [this](const auto& e) {
-                using T = std::decay_t<decltype(e)>;
-                if constexpr (std::is_same_v<T, JournalNonceBump>)
-                {
-                    get(e.addr).nonce -= 1;
-                }
-                else if constexpr (std::is_same_v<T, JournalTouched>)
-                {
-                    get(e.addr).erase_if_empty = false;
-                }
-                else if constexpr (std::is_same_v<T, JournalDestruct>)
-                {
-                    get(e.addr).destructed = false;
-                }
-                else if constexpr (std::is_same_v<T, JournalAccessAccount>)
-                {
-                    get(e.addr).access_status = EVMC_ACCESS_COLD;
-                }
-                else if constexpr (std::is_same_v<T, JournalCreate>)
-                {
-                    if (e.existed)
-                    {
-                        // This account is not always "touched". TODO: Why?
-                        auto& a = get(e.addr);
-                        a.nonce = 0;
-                        a.code_hash = Account::EMPTY_CODE_HASH;
-                        a.code.clear();
-                    }
-                    else
-                    {
-                        // TODO: Before Spurious Dragon we don't clear empty accounts ("erasable")
-                        //       so we need to delete them here explicitly.
-                        //       This should be changed by tuning "erasable" flag
-                        //       and clear in all revisions.
-                        m_modified.erase(e.addr);
-                    }
-                }
-                else if constexpr (std::is_same_v<T, JournalStorageChange>)
-                {
-                    auto& s = get(e.addr).storage.find(e.key)->second;
-                    s.current = e.prev_value;
-                    s.access_status = e.prev_access_status;
-                }
-                else if constexpr (std::is_same_v<T, JournalTransientStorageChange>)
-                {
-                    auto& s = get(e.addr).transient_storage.find(e.key)->second;
-                    s = e.prev_value;
-                }
-                else if constexpr (std::is_same_v<T, JournalBalanceChange>)
-                {
-                    get(e.addr).balance = e.prev_balance;
-                }
-                else
-                {
-                    // TODO(C++23): Change condition to `false` once CWG2518 is in.
-                    static_assert(std::is_void_v<T>, "unhandled journal entry type");
-                }
-            },
-            m_journal.back());
-        m_journal.pop_back();
-    }
+    m_journal.rollback(checkpoint, [this](const auto& e) {
+        using T = std::decay_t<decltype(e)>;
+        if constexpr (std::is_same_v<T, JournalNonceBump>)
+        {
+            get(e.addr).nonce -= 1;
+        }
+        else if constexpr (std::is_same_v<T, JournalTouched>)
+        {
+            get(e.addr).erase_if_empty = false;
+        }
+        else if constexpr (std::is_same_v<T, JournalDestruct>)
+        {
+            get(e.addr).destructed = false;
+        }
+        else if constexpr (std::is_same_v<T, JournalAccessAccount>)
+        {
+            get(e.addr).access_status = EVMC_ACCESS_COLD;
+        }
+        else if constexpr (std::is_same_v<T, JournalCreate>)
+        {
+            if (e.existed)
+            {
+                // This account is not always "touched". TODO: Why?
+                auto& a = get(e.addr);
+                a.nonce = 0;
+                a.code_hash = Account::EMPTY_CODE_HASH;
+                a.code.clear();
+            }
+            else
+            {
+                // TODO: Before Spurious Dragon we don't clear empty accounts ("erasable")
+                //       so we need to delete them here explicitly.
+                //       This should be changed by tuning "erasable" flag
+                //       and clear in all revisions.
+                m_modified.erase(e.addr);
+            }
+        }
+        else if constexpr (std::is_same_v<T, JournalStorageChange>)
+        {
+            auto& s = get(e.addr).storage.find(e.key)->second;
+            s.current = e.prev_value;
+            s.access_status = e.prev_access_status;
+        }
+        else if constexpr (std::is_same_v<T, JournalTransientStorageChange>)
+        {
+            auto& s = get(e.addr).transient_storage.find(e.key)->second;
+            s = e.prev_value;
+        }
+        else if constexpr (std::is_same_v<T, JournalBalanceChange>)
+        {
+            get(e.addr).balance = e.prev_balance;
+        }
+        else
+        {
+            // TODO(C++23): Change condition to `false` once CWG2518 is in.
+            static_assert(std::is_void_v<T>, "unhandled journal entry type");
+        }
+    });
 }
 
 /// Validates transaction and computes its execution gas limit (the amount of gas provided to EVM).
@@ -562,9 +559,9 @@ StateDiff finalize(const StateView& state_view, evmc_revision rev, const address
 
 TransactionReceipt transition(const StateView& state_view, const BlockInfo& block,
     const BlockHashes& block_hashes, const Transaction& tx, evmc_revision rev, evmc::VM& vm,
-    const TransactionProperties& tx_props)
+    const TransactionProperties& tx_props, std::pmr::memory_resource* memory)
 {
-    State state{state_view};
+    State state{state_view, memory};
 
     auto& sender_acc = state.get_or_insert(tx.sender);
     assert(sender_acc.nonce < Account::NonceMax);  // Required for valid tx.
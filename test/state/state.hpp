@@ -9,9 +9,12 @@
 #include "bloom_filter.hpp"
 #include "errors.hpp"
 #include "hash_utils.hpp"
+#include "journal.hpp"
 #include "state_diff.hpp"
 #include "state_view.hpp"
 #include "transaction.hpp"
+#include <memory_resource>
+#include <unordered_map>
 #include <variant>
 
 namespace evmone::state
@@ -59,22 +62,32 @@ class State
     struct JournalAccessAccount : JournalBase
     {};
 
-    using JournalEntry =
-        std::variant<JournalBalanceChange, JournalTouched, JournalStorageChange, JournalNonceBump,
+    using JournalType =
+        Journal<JournalBalanceChange, JournalTouched, JournalStorageChange, JournalNonceBump,
             JournalCreate, JournalTransientStorageChange, JournalDestruct, JournalAccessAccount>;
 
     /// The read-only view of the initial (cold) state.
     const StateView& m_initial;
 
     /// The accounts loaded from the initial state and potentially modified.
-    std::unordered_map<address, Account> m_modified;
+    ///
+    /// This must be a node-based container: references to accounts are held
+    /// across insertions of other accounts (e.g. the Host's recipient account handle).
+    std::pmr::unordered_map<address, Account> m_modified;
 
     /// The state journal: the list of changes made to the state
     /// with information how to revert them.
-    std::vector<JournalEntry> m_journal;
+    JournalType m_journal;
 
 public:
-    explicit State(const StateView& state_view) noexcept : m_initial{state_view} {}
+    /// Creates the state on top of the initial state view.
+    ///
+    /// The account nodes and the journal are allocated from the given memory resource.
+    /// This allows using a monotonic arena scoped to a transaction or a block.
+    explicit State(const StateView& state_view,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource()) noexcept
+      : m_initial{state_view}, m_modified{memory}, m_journal{memory}
+    {}
     State(const State&) = delete;
     State(State&&) = delete;
     State& operator=(State&&) = delete;
@@ -96,6 +109,12 @@ public:
 
     StorageValue& get_storage(const address& addr, const bytes32& key);
 
+    /// Gets the storage slot of the already looked up account.
+    ///
+    /// This skips the account lookup by address. The @p acc must be the account at @p addr,
+    /// the address is only needed to load the initial storage value.
+    StorageValue& get_storage(Account& acc, const address& addr, const bytes32& key);
+
     StateDiff build_diff(evmc_revision rev) const;
 
     /// Returns the state journal checkpoint. It can be later used to in rollback()
@@ -139,10 +158,14 @@ public:
 
 /// Executes a valid transaction.
 ///
+/// @param memory  The memory resource for the transaction's intermediate state.
+///                Nothing allocated from it outlives the call, so the caller may pass
+///                a monotonic arena and release it after the transaction or the whole block.
 /// @return Transaction receipt with state diff.
 TransactionReceipt transition(const StateView& state, const BlockInfo& block,
     const BlockHashes& block_hashes, const Transaction& tx, evmc_revision rev, evmc::VM& vm,
-    const TransactionProperties& tx_props);
+    const TransactionProperties& tx_props,
+    std::pmr::memory_resource* memory = std::pmr::get_default_resource());
 
 /// Validate a transaction.
 ///
@@ -73,7 +73,7 @@ bytes32 TestBlockHashes::get_block_hash(int64_t block_number) const noexcept
 [[nodiscard]] std::variant<state::TransactionReceipt, std::error_code> transition(TestState& state,
     const state::BlockInfo& block, const state::BlockHashes& block_hashes,
     const state::Transaction& tx, evmc_revision rev, evmc::VM& vm, int64_t block_gas_left,
-    int64_t blob_gas_left)
+    int64_t blob_gas_left, std::pmr::memory_resource* memory)
 {
     const auto tx_props_or_error =
         state::validate_transaction(state, block, tx, rev, block_gas_left, blob_gas_left);
@@ -81,7 +81,7 @@ bytes32 TestBlockHashes::get_block_hash(int64_t block_number) const noexcept
         return *err;
 
     auto receipt = state::transition(state, block, block_hashes, tx, rev, vm,
-        get<state::TransactionProperties>(tx_props_or_error));
+        get<state::TransactionProperties>(tx_props_or_error), memory);
     state.apply(receipt.state_diff);
     return receipt;
 }
@@ -5,6 +5,7 @@
 #include "transaction.hpp"
 #include "../utils/stdx/utility.hpp"
 #include "rlp.hpp"
+#include <evmone_precompiles/secp256k1.hpp>
 
 
 namespace evmone::state
@@ -97,4 +98,110 @@ namespace evmone::state
     return rlp::encode_tuple(authorization.chain_id, authorization.addr, authorization.nonce,
         authorization.v, authorization.r, authorization.s);
 }
+
+hash256 signing_hash(const Transaction& tx)
+{
+    assert(tx.type <= Transaction::Type::set_code);
+
+    const auto to = tx.to.has_value() ? bytes_view{*tx.to} : bytes_view{};
+    const auto gas_limit = static_cast<uint64_t>(tx.gas_limit);
+
+    switch (tx.type)
+    {
+    case Transaction::Type::legacy:
+        // Replay-protected transactions (EIP-155) have v = {0,1} + chain_id * 2 + 35
+        // and sign rlp [nonce, gas_price, gas_limit, to, value, data, chain_id, 0, 0].
+        // The chain ID is taken from v because tx.chain_id is not encoded in legacy transactions.
+        if (tx.v >= 35)
+        {
+            const auto chain_id = (tx.v - 35) / 2;
+            return keccak256(rlp::encode_tuple(tx.nonce, tx.max_gas_price, gas_limit, to,
+                tx.value, tx.data, chain_id, uint64_t{0}, uint64_t{0}));
+        }
+        return keccak256(
+            rlp::encode_tuple(tx.nonce, tx.max_gas_price, gas_limit, to, tx.value, tx.data));
+    case Transaction::Type::access_list:
+        return keccak256(bytes{stdx::to_underlying(tx.type)} +
+                         rlp::encode_tuple(tx.chain_id, tx.nonce, tx.max_gas_price, gas_limit, to,
+                             tx.value, tx.data, tx.access_list));
+    case Transaction::Type::eip1559:
+        return keccak256(bytes{stdx::to_underlying(tx.type)} +
+                         rlp::encode_tuple(tx.chain_id, tx.nonce, tx.max_priority_gas_price,
+                             tx.max_gas_price, gas_limit, to, tx.value, tx.data, tx.access_list));
+    case Transaction::Type::blob:
+        return keccak256(bytes{stdx::to_underlying(tx.type)} +
+                         rlp::encode_tuple(tx.chain_id, tx.nonce, tx.max_priority_gas_price,
+                             tx.max_gas_price, gas_limit, to, tx.value, tx.data, tx.access_list,
+                             tx.max_blob_gas_price, tx.blob_hashes));
+    case Transaction::Type::set_code:
+        return keccak256(bytes{stdx::to_underlying(tx.type)} +
+                         rlp::encode_tuple(tx.chain_id, tx.nonce, tx.max_priority_gas_price,
+                             tx.max_gas_price, gas_limit, to, tx.value, tx.data, tx.access_list,
+                             tx.authorization_list));
+    }
+    return {};
+}
+
+hash256 signing_hash(const Authorization& authorization)
+{
+    static constexpr uint8_t MAGIC = 0x05;
+    return keccak256(bytes{MAGIC} + rlp::encode_tuple(authorization.chain_id,
+                                        authorization.addr, authorization.nonce));
+}
+
+void recover_signers(std::span<Transaction> txs, const std::vector<bool>& sender_missing)
+{
+    assert(sender_missing.size() == txs.size());
+
+    using evmmax::secp256k1::RecoveryInput;
+
+    std::vector<RecoveryInput> inputs;
+    const auto add_input = [&inputs](const hash256& hash, const intx::uint256& r,
+                               const intx::uint256& s, const intx::uint256& y_parity) {
+        // The invalid y parity is marked with r = 0 what makes the signature invalid.
+        const auto r_or_invalid = y_parity <= 1 ? r : 0;
+        inputs.push_back({std::bit_cast<ethash::hash256>(hash), r_or_invalid, s, y_parity == 1});
+    };
+
+    for (size_t i = 0; i < txs.size(); ++i)
+    {
+        const auto& tx = txs[i];
+        if (sender_missing[i])
+        {
+            // Legacy transactions have the y parity encoded in v as {0,1} + 27
+            // or as {0,1} + chain_id * 2 + 35 (EIP-155).
+            intx::uint256 y_parity = tx.v;
+            if (tx.type == Transaction::Type::legacy)
+                y_parity = tx.v >= 35 ? (tx.v - 35) % 2 : y_parity - 27;
+            add_input(signing_hash(tx), tx.r, tx.s, y_parity);
+        }
+
+        // The signers already provided are not recovered.
+        for (const auto& auth : tx.authorization_list)
+        {
+            if (!auth.signer.has_value())
+                add_input(signing_hash(auth), auth.r, auth.s, auth.v);
+        }
+    }
+
+    std::vector<std::optional<address>> signers(inputs.size());
+    evmmax::secp256k1::ecrecover_batch(inputs, signers);
+
+    auto signer_it = signers.begin();
+    for (size_t i = 0; i < txs.size(); ++i)
+    {
+        auto& tx = txs[i];
+        if (sender_missing[i])
+        {
+            if (const auto& sender = *signer_it++; sender.has_value())
+                tx.sender = *sender;
+        }
+
+        for (auto& auth : tx.authorization_list)
+        {
+            if (!auth.signer.has_value())
+                auth.signer = *signer_it++;
+        }
+    }
+}
 }  // namespace evmone::state
@@ -8,6 +8,7 @@
 #include "state_diff.hpp"
 #include <intx/intx.hpp>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace evmone::state
@@ -137,4 +138,21 @@ struct TransactionReceipt
 
 /// Defines how to RLP-encode an Authorization (EIP-7702).
 [[nodiscard]] bytes rlp_encode(const Authorization& authorization);
+
+/// Computes the hash of the message signed by the transaction sender.
+[[nodiscard]] hash256 signing_hash(const Transaction& tx);
+
+/// Computes the hash of the message signed by the authorization signer (EIP-7702):
+/// keccak256(MAGIC || rlp([chain_id, address, nonce])).
+[[nodiscard]] hash256 signing_hash(const Authorization& authorization);
+
+/// Recovers the missing senders of the transactions and the missing signers of their
+/// authorizations from the signatures.
+///
+/// All the signatures are recovered together in a single batch.
+/// Only the senders of the transactions marked in @p sender_missing are recovered,
+/// the others are kept. The senders of the transactions with invalid signatures
+/// are not modified. Only the missing authorization signers are recovered: the signers
+/// of the invalid authorizations remain missing.
+void recover_signers(std::span<Transaction> txs, const std::vector<bool>& sender_missing);
 }  // namespace evmone::state
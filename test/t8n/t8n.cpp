@@ -11,7 +11,9 @@
 #include "../utils/utils.hpp"
 #include <evmone/evmone.h>
 #include <evmone/version.h>
+#include <evmone_precompiles/bls.hpp>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -72,6 +74,11 @@ int main(int argc, const char* argv[])
                 output_body_file = argv[i];
             else if (arg == "--trace")
                 trace = true;
+            else if (arg == "--msm-threads" && ++i < argc)
+            {
+                crypto::bls::set_msm_parallelism(
+                    static_cast<size_t>(intx::from_string<uint64_t>(argv[i])));
+            }
             else if (arg == "--state.reward" && ++i < argc)
             {
                 if (argv[i] == "-1"sv)  // Hack to compute the root hash of the pre-state.
@@ -147,10 +154,24 @@ int main(int argc, const char* argv[])
                 if (!pre_state_only)
                     test::system_call_block_start(state, block, block_hashes, rev, vm);
 
-                for (size_t i = 0; i < j_txs.size(); ++i)
+                std::vector<state::Transaction> loaded_txs;
+                std::vector<bool> sender_missing;
+                loaded_txs.reserve(j_txs.size());
+                sender_missing.reserve(j_txs.size());
+                for (const auto& j_tx : j_txs)
                 {
-                    auto tx = test::from_json<state::Transaction>(j_txs[i]);
+                    auto& tx = loaded_txs.emplace_back(test::from_json<state::Transaction>(j_tx));
                     tx.chain_id = chain_id;
+                    sender_missing.push_back(!j_tx.contains("sender"));
+                }
+
+                // Recover the missing senders of all transactions at once.
+                if (std::ranges::find(sender_missing, true) != sender_missing.end())
+                    state::recover_signers(loaded_txs, sender_missing);
+
+                for (size_t i = 0; i < j_txs.size(); ++i)
+                {
+                    auto& tx = loaded_txs[i];
 
                     const auto computed_tx_hash = keccak256(rlp::encode(tx));
                     const auto computed_tx_hash_str = hex0x(computed_tx_hash);
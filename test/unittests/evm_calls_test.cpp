@@ -319,6 +319,27 @@ TEST_P(evm, call_output)
     }
 }
 
+TEST_P(evm, call_output_large)
+{
+    // The large call output is copied to the memory with the non-temporal stores.
+    // Use the unaligned memory offset.
+    static const auto call_output = [] {
+        bytes b(1024 * 1024 + 77, 0);
+        for (size_t i = 0; i < b.size(); ++i)
+            b[i] = static_cast<uint8_t>(i * 7);
+        return b;
+    }();
+    host.call_result.output_data = call_output.data();
+    host.call_result.output_size = call_output.size();
+
+    const auto size = call_output.size();
+    execute(call(0).output(1, size) + ret(0, size + 1));
+    EXPECT_EQ(result.status_code, EVMC_SUCCESS);
+    ASSERT_EQ(result.output_size, size + 1);
+    EXPECT_EQ(result.output_data[0], 0);
+    EXPECT_EQ(bytes_view(&result.output_data[1], size), call_output);
+}
+
 TEST_P(evm, call_high_gas)
 {
     rev = EVMC_HOMESTEAD;
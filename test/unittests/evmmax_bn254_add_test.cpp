@@ -160,3 +160,36 @@ TEST(evmmax, inv_1)
     const auto p = m.mul(a, a_inv);
     EXPECT_EQ(m.from_mont(p), 1);
 }
+
+TEST(evmmax, bn254_batch_to_affine)
+{
+    const evmmax::ModArith<uint256> m{FieldPrime};
+    const auto b3 = m.to_mont(3 * 3);
+
+    // The multiples [i]G in projective coordinates with z != 1 and the infinity in between.
+    std::vector<evmmax::ecc::ProjPoint<uint256>> points;
+    const auto g = evmmax::ecc::to_proj(m, Point{1, 2});
+    auto q = g;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        points.push_back(q);
+        q = evmmax::ecc::add(m, q, g, b3);
+    }
+    points.insert(points.begin() + 3, evmmax::ecc::ProjPoint<uint256>{});
+
+    std::vector<Point> affine_points(points.size());
+    evmmax::ecc::batch_to_affine(m, field_inv, points, affine_points);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        if (points[i].is_inf())
+        {
+            EXPECT_TRUE(affine_points[i].is_inf());
+            continue;
+        }
+        const Point e = evmmax::ecc::to_affine(m, field_inv, points[i]);
+        EXPECT_EQ(m.from_mont(affine_points[i].x), e.x);
+        EXPECT_EQ(m.from_mont(affine_points[i].y), e.y);
+        EXPECT_TRUE(validate(e));
+    }
+}
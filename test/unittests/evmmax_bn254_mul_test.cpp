@@ -206,7 +206,21 @@ const TestCase
                 {"0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000"_hex,
                     "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"_hex},
                 {"0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000000"_hex,
+                    "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000002"_hex},                // The GLV endomorphism edge cases: [λ]G = (βx, y), scalars ≥ N and 128-bit scalars.
+                {"0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000230644e72e131a029048b6e193fd84104cc37a73fec2bc5e9b8ca0b2d36636f23"_hex,
+                    "30644e72e131a0295e6dd9e7e0acccb0c28f069fbb966e3de4bd44e5607cfd480000000000000000000000000000000000000000000000000000000000000002"_hex},
+                {"0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000230644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000000"_hex,
+                    "000000000000000000000000000000000000000000000000000000000000000130644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd45"_hex},
+                {"0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000230644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000002"_hex,
                     "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000002"_hex},
+                {"00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000002ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"_hex,
+                    "2f588cffe99db877a4434b598ab28f81e0522910ea52b45f0adaa772b2d5d35212f42fa8fd34fb1b33d8c6a718b6590198389b26fc9d8808d971f8b009777a97"_hex},
+                {"0f25929bcb43d5a57391564615c9e70a992b10eafa4db109709649cf48c50dd216da2f5cb6be7a0aa72c440c53c9bbdfec6c36c7d515536431b3a865468acbba00000000000000000000000000000000ffffffffffffffffffffffffffffffff"_hex,
+                    "16e11304aa16db7e05a757bd505f3713ce6e3c049fc423471be2cfcba9c35c802b8b262bc1556d6f680b0365af4ace06f72194344f00b9aa9a525dcad0047141"_hex},
+                {"0f25929bcb43d5a57391564615c9e70a992b10eafa4db109709649cf48c50dd216da2f5cb6be7a0aa72c440c53c9bbdfec6c36c7d515536431b3a865468acbba0000000000000000b3c4d79d41a917585bfc41088d8daaa78b17ea66b99c90de"_hex,
+                    "2155b051571649d4d77397a0f2e4018869b3e0b3af2e2ce5f8b3d79cfc4392e6198a1f162a73261f112401aa2db79c7dab1533c9935c77290a6ce3b191f2318d"_hex},
+                {"0f25929bcb43d5a57391564615c9e70a992b10eafa4db109709649cf48c50dd216da2f5cb6be7a0aa72c440c53c9bbdfec6c36c7d515536431b3a865468acbba8000000000000000000000000000000000000000000000000000000000003039"_hex,
+                    "1c04f2f97e3450632ea011e76015d05416a2753c97851d6bf42a75a42e26f4bf26e28c4138ac640699ea9ccef1fe83a9bd44c98192e7184c79f23422119226de"_hex},
 };
 }  // namespace
 
@@ -242,3 +256,35 @@ TEST(evmmax, bn254_pt_mul)
         EXPECT_EQ(r, e);
     }
 }
+
+TEST(evmmax, bn254_mul_generator)
+{
+    // The multiplication of the generator uses the precomputed table.
+    // Check it against the generic multiplication of other points:
+    // [a·b]G == [b]([a]G) and [a]G + [b]G == [a + b]G.
+    const Point g{1, 2};
+    const uint256 scalars[]{
+        1,
+        2,
+        0x20,
+        0x21,
+        0x3f,
+        // All 6-bit windows are 0b100000, 0b100001 or 0b111111: the edges of the signed digits.
+        0x20820820820820820820820820820820820820820820820820820820820820_u256,
+        0x21861861861861861861861861861861861861861861861861861861861861_u256,
+        0x3fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff_u256,
+        0x2000000000000000000000000000000000000000000000000000000000000000_u256,
+        0x2b4ad1a3a5d3e8b6f0c7e9a1d2c3b4a5968778695a4b3c2d1e0f1a2b3c4d5e6f_u256,
+        Order - 1,
+    };
+    const auto a = 0x0f25929bcb43d5a57391564615c9e70a992b10eafa4db109709649cf48c50dd2_u256;
+    const auto a_g = mul(g, a);
+
+    for (const auto& b : scalars)
+    {
+        const auto b_g = mul(g, b);
+        EXPECT_TRUE(validate(b_g));
+        EXPECT_EQ(mul(g, mulmod(a, b, Order)), mul(a_g, b)) << to_string(b, 16);
+        EXPECT_EQ(mul(g, addmod(a, b, Order)), add(a_g, b_g)) << to_string(b, 16);
+    }
+}
@@ -94,6 +94,58 @@ TEST(evmmax, bn254_pairing)
         EXPECT_EQ(pairing_check(pairs), true);
     }
 
+    {
+        // The same G2 point in multiple pairs, mixed with the infinity G1 point.
+        // p1*q1 + p1*q1 + 0*q1 + (-p1*q1) = 0?
+        const std::vector<std::pair<Point, ExtPoint>> pairs{
+            {P1, Q1},
+            {P1, Q1},
+            {Point{}, Q1},
+            {nP1, Q1},
+        };
+        EXPECT_EQ(pairing_check(pairs), false);
+
+        // p1*q1 + 0*q1 + p1*17*q1 - (p1 * -q1*17) + (-p1*q1) = 0?
+        const std::vector<std::pair<Point, ExtPoint>> pairs2{
+            {P1, Q1},
+            {Point{}, Q1},
+            {P1_17, Q1},
+            {P1, nQ1_17},
+            {nP1, Q1},
+        };
+        EXPECT_EQ(pairing_check(pairs2), true);
+    }
+
+    {
+        // More distinct G2 points and pairs than the pairing check processes in a single batch.
+        const auto Q1_16 =
+            ExtPoint{nQ1_16.x, {FieldPrime - nQ1_16.y.first, FieldPrime - nQ1_16.y.second}};
+        const auto Q1_17 =
+            ExtPoint{nQ1_17.x, {FieldPrime - nQ1_17.y.first, FieldPrime - nQ1_17.y.second}};
+        const std::vector<std::pair<Point, ExtPoint>> pairs{
+            {P1, Q1},
+            {P1, nQ1},
+            {P1, nQ1_16},
+            {P1, Q1_16},
+            {P1_17, Q1},
+            {P1, nQ1_17},
+            {P1, Q1_17},
+            {P1, nQ1_17},
+        };
+        std::vector<std::pair<Point, ExtPoint>> many_pairs;
+        for (int i = 0; i < 3; ++i)
+            many_pairs.insert(many_pairs.end(), pairs.begin(), pairs.end());
+
+        g2_cache_clear();
+        EXPECT_EQ(pairing_check(pairs), true);
+        g2_cache_clear();
+        EXPECT_EQ(pairing_check(many_pairs), true);
+        EXPECT_EQ(pairing_check(many_pairs), true);
+
+        many_pairs.back().first = P1_17;
+        EXPECT_EQ(pairing_check(many_pairs), false);
+    }
+
     // Empty input
     {
         EXPECT_EQ(pairing_check({}), true);
@@ -167,3 +219,57 @@ TEST(evmmax, bn254_pairing_invalid_input)
         EXPECT_EQ(pairing_check(input), std::nullopt);
     }
 }
+
+TEST(evmmax, bn254_pairing_g2_cache)
+{
+    const auto P = Point{
+        0x1c76476f4def4bb94541d57ebba1193381ffa7aa76ada664dd31c16024c43f59_u256,
+        0x3034dd2920f673e204fee2811c678745fc819b55d3e9d294e45c9b03a76aef41_u256,
+    };
+    const auto nP = Point{P.x, FieldPrime - P.y};
+    const auto Q = ExtPoint{
+        {
+            0x04bf11ca01483bfa8b34b43561848d28905960114c8ac04049af4b6315a41678_u256,
+            0x209dd15ebff5d46c4bd888e51a93cf99a7329636c63514396b4a452003a35bf7_u256,
+        },
+        {
+            0x120a2a4cf30c1bf9845f20c6fe39e07ea2cce61f0c9bb048165fe5e4de877550_u256,
+            0x2bb8324af6cfc93537a2ad1a445cfd0ca2a71acd7ac41fadbf933c2a51be344d_u256,
+        },
+    };
+    const std::vector<std::pair<Point, ExtPoint>> pairs{{P, Q}, {nP, Q}};
+
+    g2_cache_clear();
+    EXPECT_EQ(g2_cache_stats().size, 0);
+
+    // The G2 point used twice is looked up once.
+    EXPECT_EQ(pairing_check(pairs), true);
+    auto stats = g2_cache_stats();
+    EXPECT_EQ(stats.hits, 0);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.size, 1);
+
+    EXPECT_EQ(pairing_check(pairs), true);
+    EXPECT_EQ(pairing_check(pairs), true);
+    stats = g2_cache_stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.size, 1);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 2.0 / 3.0);
+
+    // The invalid G2 point is not cached.
+    auto invalid_pairs = pairs;
+    invalid_pairs[1].second.x.first += 1;
+    EXPECT_EQ(pairing_check(invalid_pairs), std::nullopt);
+    EXPECT_EQ(pairing_check(invalid_pairs), std::nullopt);
+    stats = g2_cache_stats();
+    EXPECT_EQ(stats.hits, 4);
+    EXPECT_EQ(stats.misses, 3);
+    EXPECT_EQ(stats.size, 1);
+
+    g2_cache_clear();
+    stats = g2_cache_stats();
+    EXPECT_EQ(stats.hits, 0);
+    EXPECT_EQ(stats.misses, 0);
+    EXPECT_EQ(stats.size, 0);
+}
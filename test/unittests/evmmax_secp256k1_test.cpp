@@ -305,6 +305,24 @@ static const TestCaseECR test_cases_ecr[] = {
         0x3134a4ba8fafe11b351a720538398a5635e235c0b3258dce19942000731079ec_u256, false,
         {0x43ec87f8ee6f58605d947dac51b5e4cfe26705f509e5dad058212aadda180835_u256,
             0x90ebad786ce091f5af1719bf30ee236a4e6ce8a7ab6c36a16c93c6177aa109df_u256}},
+    // u1 = 0
+    {0x0000000000000000000000000000000000000000000000000000000000000000_bytes32,
+        0x18072e8c35bf992dc9e9c616612e7696a6cecc1b78e510617311d8a3c2ce6f45_u256,
+        0xc324c9859b810e766ec9d28663ca828dd5f4b3b2e4b06ce60741c7a87ce42c83_u256, false,
+        {0x9a65ca4792280cdf28a75d38641b1ae0841170c71ef928f6f403cd8f8134e909_u256,
+            0xbe4fefe73dca12eb481ac1bfc7eacdee8fedf8ffe96029dd27efc5783e52d545_u256}},
+    // small s
+    {0x69d495dd81355c53f0e642f43328ad088ded3c9691eb79fa5d5f576cdeb8fc4c_bytes32,
+        0x9f9d01298a449ebe89d9bf020067dba8589890086a17b9af5b569643d037ce00_u256,
+        0x8cfe6_u256, false,
+        {0xe058e24602b76313b2b25a00f87176081c0ea286790623243d1a07c3992312e6_u256,
+            0xe8b5b8a1075842e7507943b36cfa079300a83f72d0b813c3b8ffed1d4186e187_u256}},
+    // R = G
+    {0x334de73d60c290d00994940e82458cc89f7a7dafb43adc4fc7af3626f9495568_bytes32,
+        0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798_u256,
+        0x7ff2e341810d2e304bcb6b2263db01fcaa7c314bf01dbf291abb8ba37e0ab2ee_u256, false,
+        {0x4cf52b7ab8d88ffced96116724da711ce5547038cbc0c77510c957a092a4a730_u256,
+            0xdce3ff1eb5b30d8daa16435051000f1c8fac27df4c3a89af2b9b180d659c19e6_u256}},
 };
 
 TEST(evmmax, ecr)
@@ -320,6 +338,16 @@ TEST(evmmax, ecr)
     }
 }
 
+TEST(evmmax, ecr_inf)
+{
+    // R = [k]G and z = s⋅k what gives the public key Q = [-z/r]G + [s/r]R at infinity.
+    ethash::hash256 h{};
+    intx::be::unsafe::store(h.bytes, 0x64dc3d2f1f2fc458e84585_u256);
+    const auto r = 0x32b0d10d8d0e04bc8d4d064d270699e87cffc9b49c5c20730e1c26f6105ddcda_u256;
+    const auto s = 0x3ade68b1_u256;
+    EXPECT_FALSE(secp256k1_ecdsa_recover(h, r, s, true).has_value());
+}
+
 
 struct TestCaseECRecovery
 {
@@ -379,3 +407,29 @@ TEST(evmmax, ecrecovery)
         }
     }
 }
+
+TEST(evmmax, ecrecover_batch)
+{
+    std::vector<RecoveryInput> inputs;
+    for (const auto& t : test_cases)
+    {
+        RecoveryInput in;
+        std::memcpy(in.e.bytes, t.input.data(), 32);
+        in.v = be::unsafe::load<uint256>(&t.input[32]) == 28;
+        in.r = be::unsafe::load<uint256>(&t.input[64]);
+        in.s = be::unsafe::load<uint256>(&t.input[96]);
+        inputs.emplace_back(in);
+    }
+    for (const auto& t : test_cases_ecr)
+        inputs.push_back({std::bit_cast<ethash::hash256>(t.hash), t.r, t.s, t.parity});
+
+    std::vector<std::optional<evmc::address>> results(inputs.size());
+    ecrecover_batch(inputs, results);
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        const auto& [e, r, s, v] = inputs[i];
+        EXPECT_EQ(results[i], ecrecover(e, r, s, v)) << i;
+    }
+
+    ecrecover_batch({}, {});
+}
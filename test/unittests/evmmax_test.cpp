@@ -5,6 +5,9 @@
 #include <evmmax/evmmax.hpp>
 #include <gtest/gtest.h>
 #include <array>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace intx;
 using namespace evmmax;
@@ -14,6 +17,10 @@ constexpr auto BN254Mod = 0x30644e72e131a029b85045b68181585d97816a916871ca8d3c20
 constexpr auto Secp256k1Mod =
     0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f_u256;
 constexpr auto M256 = 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff_u256;
+/// The sparse modulus for which the Montgomery multiplication of values near 2^256 overflows
+/// without the carry handling.
+constexpr auto Sparse254Mod =
+    0x28b20257daa6aa417c3114add522f9833fb81641257bb9decae51f2b2c7b042f_u256;
 constexpr auto BLS12384Mod =
     0x1a0111ea397fe69a4b1ba7b6434bacd764774b84f38512bf6730d2a0f6b0f6241eabfffeb153ffffb9feffffffffaaab_u384;
 
@@ -25,12 +32,21 @@ struct ModA : ModArith<UintT>
     ModA() : ModArith<UintT>{Mod} {}
 };
 
+template <typename UintT, const UintT& Mod>
+struct SparseModA : SparseModArith<UintT>
+{
+    using uint = UintT;
+    SparseModA() : SparseModArith<UintT>{Mod} {}
+};
+
 template <typename>
 class evmmax_test : public testing::Test
 {};
 
 using test_types = testing::Types<ModA<uint256, P23>, ModA<uint256, BN254Mod>,
-    ModA<uint256, Secp256k1Mod>, ModA<uint256, M256>, ModA<uint384, BLS12384Mod>>;
+    ModA<uint256, Secp256k1Mod>, ModA<uint256, M256>, ModA<uint384, BLS12384Mod>,
+    SparseModA<uint256, P23>, SparseModA<uint256, BN254Mod>, SparseModA<uint256, Sparse254Mod>,
+    SparseModA<uint384, BLS12384Mod>>;
 TYPED_TEST_SUITE(evmmax_test, test_types, testing::internal::DefaultNameGenerator);
 
 TYPED_TEST(evmmax_test, to_from_mont)
@@ -49,6 +65,15 @@ TYPED_TEST(evmmax_test, to_from_mont_0)
     EXPECT_EQ(s.from_mont(0), 0);
 }
 
+TYPED_TEST(evmmax_test, to_mont_unreduced)
+{
+    // The conversion accepts any value, also the ones much bigger than the modulus.
+    using Uint = typename TypeParam::uint;
+    const TypeParam s;
+    for (const auto& x : {~Uint{0}, ~Uint{0} - 1, ~Uint{0} >> 1, ~Uint{0} >> 2, s.mod * 3 + 1})
+        EXPECT_EQ(s.from_mont(s.to_mont(x)), x % s.mod) << to_string(x);
+}
+
 template <typename Mod>
 static auto get_test_values(const Mod& m) noexcept
 {
@@ -76,6 +101,16 @@ static auto get_test_values(const Mod& m) noexcept
     static_assert(m.add(a, b) == m.to_mont(14));
     static_assert(m.sub(a, b) == m.to_mont(BN254Mod - 8));
     static_assert(m.mul(a, b) == m.to_mont(33));
+    static_assert(m.mul(m.inv(a), a) == m.to_mont(1));
+
+    static_assert(!m.is_sparse());
+
+    static constexpr SparseModArith sm{BN254Mod};
+    static_assert(sm.is_sparse());
+    static_assert(sm.to_mont(3) == a);
+    static_assert(sm.add(a, b) == m.add(a, b));
+    static_assert(sm.mul(a, b) == m.mul(a, b));
+    static_assert(sm.mul(a + m.mod, b + m.mod) == m.mul(a, b));
 }
 
 TYPED_TEST(evmmax_test, add)
@@ -147,3 +182,104 @@ TYPED_TEST(evmmax_test, mul)
         }
     }
 }
+
+TYPED_TEST(evmmax_test, mul_lazy_inputs)
+{
+    const TypeParam m;
+    if (!TypeParam::is_sparse())
+        GTEST_SKIP() << "lazy reduction requires the sparse modulus";
+
+    const auto values = get_test_values(m);
+    for (const auto& x : values)
+    {
+        const auto xm = m.to_mont(x);
+        for (const auto& y : values)
+        {
+            const auto ym = m.to_mont(y);
+            const auto s = m.add(xm, ym);
+            const auto s_lazy = xm + ym;  // Not reduced: s_lazy < 2mod.
+            EXPECT_EQ(m.mul(s_lazy, s_lazy), m.mul(s, s));
+            for (const auto& z : values)
+                EXPECT_EQ(m.mul(s_lazy, m.to_mont(z)), m.mul(s, m.to_mont(z)));
+        }
+    }
+}
+
+TYPED_TEST(evmmax_test, mul_batch)
+{
+    // Compare the CPU-specific implementations of the mul_batch() with the mul().
+    const TypeParam m;
+    const auto values = get_test_values(m);
+
+    std::vector<typename TypeParam::uint> xs;
+    std::vector<typename TypeParam::uint> ys;
+    std::vector<typename TypeParam::uint> expected;
+    for (const auto& x : values)
+    {
+        for (const auto& y : values)
+        {
+            xs.push_back(m.to_mont(x));
+            ys.push_back(m.to_mont(y));
+            expected.push_back(m.mul(xs.back(), ys.back()));
+        }
+    }
+
+    // Force each implementation supported by the CPU.
+    const std::string selected = mul_batch_implementation();
+    for (const auto* impl : {"portable", "adx", "avx512ifma"})
+    {
+        if (!set_mul_batch_implementation(impl))
+            continue;
+
+        // Check the batch sizes not being multiples of the SIMD width.
+        for (const size_t n : {size_t{0}, size_t{1}, size_t{7}, size_t{8}, size_t{13}, xs.size()})
+        {
+            std::vector<typename TypeParam::uint> r(n);
+            m.mul_batch(r, std::span{xs}.first(n), std::span{ys}.first(n));
+            for (size_t i = 0; i < n; ++i)
+                EXPECT_EQ(r[i], expected[i]) << impl << " n=" << n << " i=" << i;
+        }
+
+        // The output may be one of the inputs.
+        auto r = xs;
+        m.mul_batch(r, r, ys);
+        EXPECT_EQ(r, expected) << impl;
+    }
+    EXPECT_TRUE(set_mul_batch_implementation(selected));
+    EXPECT_FALSE(set_mul_batch_implementation("unknown"));
+    EXPECT_EQ(mul_batch_implementation(), selected);
+}
+
+TYPED_TEST(evmmax_test, inv)
+{
+    if constexpr (TypeParam::uint::num_bits != 256)
+        GTEST_SKIP() << "inv() is only implemented for 256-bit moduli";
+    else
+    {
+        const TypeParam m;
+        const auto values = get_test_values(m);
+        const auto one = m.to_mont(1);
+
+        EXPECT_EQ(m.inv(0), 0);
+
+        for (const auto& x : values)
+        {
+            // Skip the values not coprime with the modulus (the M256 is not prime).
+            auto a = m.mod;
+            auto b = x;
+            while (b != 0)
+            {
+                a = udivrem(a, b).rem;
+                std::swap(a, b);
+            }
+            if (a != 1)
+                continue;
+
+            const auto xm = m.to_mont(x);
+            const auto x_inv = m.inv(xm);
+            EXPECT_LT(x_inv, m.mod);
+            EXPECT_EQ(m.mul(xm, x_inv), one) << to_string(x);
+            EXPECT_EQ(m.inv(x_inv), xm);
+        }
+    }
+}
@@ -79,3 +79,49 @@ TEST(blake2b_compress, null_input)
     // For null input you get the IV as the result.
     EXPECT_EQ(h, blake2b_iv);
 }
+
+TEST(blake2b_compress, rounds)
+{
+    // The RFC reference input with various numbers of rounds, including the round counts
+    // not multiple of the message schedule length 10.
+
+    using evmone::test::hex;
+
+    auto h_init = blake2b_iv;
+    h_init[0] ^= 0x01010000 ^ /*outlen = */ 64;
+
+    const std::string_view data = "abc";
+    uint64_t m[16]{};
+    std::memcpy(m, data.data(), data.size());
+
+    const uint64_t t[2]{data.size(), 0};
+
+    const std::pair<uint32_t, std::string_view> test_cases[] = {
+        {1,
+            "b63a380cb2897d521994a85234ee2c181b5f844d2c624c002677e9703449d2fb"
+            "a551b3a8333bcdf5f2f7e08993d53923de3d64fcc68c034e717b9293fed7a421"},
+        {10,
+            "5a4308e0e1daede181b47775d926a6b4b6a0adf86d05bfea696fac45f0841962"
+            "3976bd3c786f61500b9f94a043b9dcf397e38ee237f3c273a7d812be20874f5a"},
+        {11,
+            "60faa8f91624b2b718210df242b788c7ae887e953dce3c7f80862bc5e4f88d82"
+            "7cada4d95d2c4ac41eb66b84fcdc0e12ab0c66f4d9d546ff8a0d712f324e1845"},
+        {20,
+            "0c1b96fc9c06898bb49af24ef91a669143df8e847807765da43f8ad6c0ec5180"
+            "e6ab033a21428e52c5d933345f81d8300a02158704935b7a020d990572ad9be0"},
+        {1000,
+            "f92ac5126772237de3d2353169fe7697d4af3af4382778b05c7bb12e48903fbe"
+            "cefe56df2b901796d385e58cf759690a1bbec1aa9d95b5fa3ee79a575f116915"},
+        {1 << 20,
+            "1f5eb2b66681f1b84a8da1405604128292e2d6f9b11cbc89c6c603299eea703d"
+            "5cfebb818543cbb293655f7c87bb567298fd957412e7720da95133452504f097"},
+    };
+
+    for (const auto& [rounds, expected_hex] : test_cases)
+    {
+        auto h = h_init;
+        blake2b_compress(rounds, h.data(), m, t, true);
+        EXPECT_EQ(hex({reinterpret_cast<const uint8_t*>(h.data()), sizeof(h)}), expected_hex)
+            << rounds;
+    }
+}
@@ -343,6 +343,113 @@ TEST(bls, g2_msm_inf_3)
     EXPECT_EQ(evmc::bytes_view(ry, sizeof ry), expected_y);
 }
 
+TEST(bls, g1_msm_sizes)
+{
+    // The MSM of n generators with the scalars 1, 2, ..., n is [n(n+1)/2]G.
+    // This covers both the small-input path and the Pippenger's algorithm,
+    // and the reuse of the MSM buffers between calls of decreasing sizes.
+    const size_t sizes[] = {1, 2, 3, 4, 5, 6, 8, 16, 33, 8, 5, 4, 1};
+    for (const auto n : sizes)
+    {
+        evmc::bytes input;
+        for (size_t i = 1; i <= n; ++i)
+        {
+            uint8_t c[32]{};
+            c[31] = static_cast<uint8_t>(i);
+            input += G1_1 + evmc::bytes{c, sizeof(c)};
+        }
+
+        uint8_t rx[64];
+        uint8_t ry[64];
+        ASSERT_TRUE(evmone::crypto::bls::g1_msm(rx, ry, input.data(), input.size()));
+
+        uint8_t c[32]{};
+        c[30] = static_cast<uint8_t>((n * (n + 1) / 2) >> 8);
+        c[31] = static_cast<uint8_t>(n * (n + 1) / 2);
+        uint8_t ex[64];
+        uint8_t ey[64];
+        ASSERT_TRUE(evmone::crypto::bls::g1_mul(ex, ey, G1_1.data(), &G1_1[64], c));
+
+        EXPECT_EQ(evmc::bytes_view(rx, sizeof rx), evmc::bytes_view(ex, sizeof ex)) << n;
+        EXPECT_EQ(evmc::bytes_view(ry, sizeof ry), evmc::bytes_view(ey, sizeof ey)) << n;
+    }
+}
+
+TEST(bls, g2_msm_sizes)
+{
+    // The MSM of n generators with the scalars 1, 2, ..., n is [n(n+1)/2]G.
+    const size_t sizes[] = {1, 2, 3, 4, 5, 6, 8, 16, 33, 8, 5, 4, 1};
+    for (const auto n : sizes)
+    {
+        evmc::bytes input;
+        for (size_t i = 1; i <= n; ++i)
+        {
+            uint8_t c[32]{};
+            c[31] = static_cast<uint8_t>(i);
+            input += G2_1 + evmc::bytes{c, sizeof(c)};
+        }
+
+        uint8_t rx[128];
+        uint8_t ry[128];
+        ASSERT_TRUE(evmone::crypto::bls::g2_msm(rx, ry, input.data(), input.size()));
+
+        uint8_t c[32]{};
+        c[30] = static_cast<uint8_t>((n * (n + 1) / 2) >> 8);
+        c[31] = static_cast<uint8_t>(n * (n + 1) / 2);
+        uint8_t ex[128];
+        uint8_t ey[128];
+        ASSERT_TRUE(evmone::crypto::bls::g2_mul(ex, ey, G2_1.data(), &G2_1[128], c));
+
+        EXPECT_EQ(evmc::bytes_view(rx, sizeof rx), evmc::bytes_view(ex, sizeof ex)) << n;
+        EXPECT_EQ(evmc::bytes_view(ry, sizeof ry), evmc::bytes_view(ey, sizeof ey)) << n;
+    }
+}
+
+TEST(bls, msm_parallel)
+{
+    // The parallel MSM must give the same results as in the g1_msm_sizes and g2_msm_sizes tests.
+    // The chunks are at least 32 points so this covers 2, 3 and 4 chunks.
+    evmone::crypto::bls::set_msm_parallelism(4, 64);
+
+    const size_t sizes[] = {63, 64, 100, 128, 255};
+    for (const auto n : sizes)
+    {
+        evmc::bytes input1;
+        evmc::bytes input2;
+        for (size_t i = 1; i <= n; ++i)
+        {
+            uint8_t c[32]{};
+            c[31] = static_cast<uint8_t>(i);
+            input1 += G1_1 + evmc::bytes{c, sizeof(c)};
+            input2 += G2_1 + evmc::bytes{c, sizeof(c)};
+        }
+
+        uint8_t c[32]{};
+        c[30] = static_cast<uint8_t>((n * (n + 1) / 2) >> 8);
+        c[31] = static_cast<uint8_t>(n * (n + 1) / 2);
+
+        uint8_t rx1[64];
+        uint8_t ry1[64];
+        ASSERT_TRUE(evmone::crypto::bls::g1_msm(rx1, ry1, input1.data(), input1.size()));
+        uint8_t ex1[64];
+        uint8_t ey1[64];
+        ASSERT_TRUE(evmone::crypto::bls::g1_mul(ex1, ey1, G1_1.data(), &G1_1[64], c));
+        EXPECT_EQ(evmc::bytes_view(rx1, sizeof rx1), evmc::bytes_view(ex1, sizeof ex1)) << n;
+        EXPECT_EQ(evmc::bytes_view(ry1, sizeof ry1), evmc::bytes_view(ey1, sizeof ey1)) << n;
+
+        uint8_t rx2[128];
+        uint8_t ry2[128];
+        ASSERT_TRUE(evmone::crypto::bls::g2_msm(rx2, ry2, input2.data(), input2.size()));
+        uint8_t ex2[128];
+        uint8_t ey2[128];
+        ASSERT_TRUE(evmone::crypto::bls::g2_mul(ex2, ey2, G2_1.data(), &G2_1[128], c));
+        EXPECT_EQ(evmc::bytes_view(rx2, sizeof rx2), evmc::bytes_view(ex2, sizeof ex2)) << n;
+        EXPECT_EQ(evmc::bytes_view(ry2, sizeof ry2), evmc::bytes_view(ey2, sizeof ey2)) << n;
+    }
+
+    evmone::crypto::bls::set_msm_parallelism(1);
+}
+
 TEST(bls, map_fp_to_g1)
 {
     using namespace evmc::literals;
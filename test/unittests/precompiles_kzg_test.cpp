@@ -7,10 +7,16 @@
 #include <evmone_precompiles/sha256.hpp>
 #include <gtest/gtest.h>
 #include <intx/intx.hpp>
+#include <test/utils/utils.hpp>
+#include <algorithm>
+#include <cstring>
 #include <span>
 
 using namespace evmc::literals;
 using namespace evmone::crypto;
+using evmone::test::operator""_hex;
+using evmc::bytes;
+using evmc::bytes_view;
 
 namespace
 {
@@ -32,6 +38,54 @@ auto versioned_hash(std::span<const std::byte> input) noexcept
     hash[0] = VERSIONED_HASH_VERSION_KZG;
     return hash;
 }
+
+/// The compressed form of the G1 generator point [1]₁.
+auto g1_generator() noexcept
+{
+    std::array<std::byte, 48> p{};
+    intx::be::store(reinterpret_cast<uint8_t(&)[48]>(p), G1_GENERATOR_X);
+    p[0] |= std::byte{0x80};  // flag of the point compressed form.
+    return p;
+}
+
+/// The valid proof input for the polynomial f(x) = c (c is 0 or 1) evaluated at z.
+KzgProofInput constant_proof_input(uint8_t c, uint8_t z) noexcept
+{
+    KzgProofInput in{};
+    std::ranges::copy(POINT_AT_INFINITY, in.commitment.begin());
+    if (c != 0)
+        in.commitment = g1_generator();
+    in.versioned_hash = versioned_hash(in.commitment);
+    in.z[31] = std::byte{z};
+    in.y[31] = std::byte{c};
+    std::ranges::copy(POINT_AT_INFINITY, in.proof.begin());
+    return in;
+}
+
+/// The valid point evaluation precompile inputs from Mainnet.
+const bytes MAINNET_INPUTS[]{
+    "012b08a0504a63aac18383db69fe6b52fc833e3d060b87c2726c4140c909d91807dddd3c80995c2bb3012943e2036e77490b1f6ddc58ca39a4fb4f3225ae56ab11dc2c4d89f777f0f5c2a51f45b73ff1538761f9cf23ed74c74472fea625ad8bace1db77e25ceb316d914182e05dd810f112352e1d6ed9e47af28e2f64e22b94c411794359c2273bc10bc0390963fb1a97bb642307bfa4424c66bd90ecc0ecffd5045e492b40304df20346693db7450457e2c72588a6a2b1a16909e2ab1e6284"_hex,
+    "019cd755316533108b9eade41e35a16442ae76acd5b7d4e8903ecb9d9f48348a00000000000000000000000000000000dd372dcb4e5565861fc29cfb12f4373861e6e2dfca75084191a505f7988db8e82a4a4a09734b6fd7677d590a1cb512768c381fc4957f406ef89996d9dfa1d39b5c8d1368569e56fd61036c537400a3f4515eeb0c4d183142daa2c30423e0c3fa84667445c1669d3a3e3fce8a1144811e4452841399318c21cca9d20c91fb162929c4e96d391b70158bcd4c69b682b272"_hex,
+    "0187576b6a38dd4ca8ce00e35dd12d1dd91e06ba3bde49d01568103d826d59732fd172adc351401950681fb66f9464410b15437ab00599aede3f90d0d9552bd162920cfc9b91d123f2c24034006fc9b7f5217cfae1022be231b6bd37262fda83ac48e50cbfeeee227daee56a8bff2f96ede7757b6f2598bd40b14d75b04c07a92299443d1eabe857f57fc95b0ca8b121adff55fad542926063245c402008a846c60eeca2e419a3e9e12ddfc0184a606b31d39268d8b580b57ac274501858bdb5"_hex,
+    "0145e6c573f2f24f95eeddb687df7da5da51ae1d58bc3691ff52c8d667e704db0000000000000000000000000000000076231706fc7f1f5cd05a88ed538b74ab2672abe246a6042b24c709294ea2e85672a6edc7aee8ab556adfd7af889086afa1bf23edb5e0300f4d924350197c497f084af76365a6209c4b93f00b1ffc803fb7847ca51f4fc1df4fdb9298c16d6a1ea038d42f9ffa40e872eb722e095ea19ff4f2e891a2676b93905476bc8186b741f64c7281f7bba1a14e086316bf5e4b67"_hex,
+};
+
+/// The proof input of the point evaluation precompile input.
+KzgProofInput proof_input(bytes_view precompile_input) noexcept
+{
+    KzgProofInput in{};
+    std::memcpy(&in, precompile_input.data(), sizeof(in));
+    return in;
+}
+
+/// The proof inputs from the point evaluation precompile inputs.
+auto proof_inputs(std::span<const bytes> precompile_inputs)
+{
+    std::vector<KzgProofInput> r;
+    for (const auto& input : precompile_inputs)
+        r.push_back(proof_input(input));
+    return r;
+}
 }  // namespace
 
 TEST(kzg, verify_proof_hash_invalid)
@@ -67,3 +121,127 @@ TEST(kzg, verify_proof_constant)
     const auto r = kzg_verify_proof(hash.data(), z, y, c, POINT_AT_INFINITY);
     EXPECT_TRUE(r);
 }
+
+TEST(kzg, verify_proof_batch)
+{
+    EXPECT_TRUE(kzg_verify_proof_batch({}));
+
+    const KzgProofInput inputs[]{constant_proof_input(0, 1), constant_proof_input(1, 2),
+        constant_proof_input(1, 3), constant_proof_input(0, 4)};
+    EXPECT_TRUE(kzg_verify_proof_batch(inputs));
+    EXPECT_TRUE(kzg_verify_proof_batch(std::span{inputs, 1}));
+    EXPECT_TRUE(kzg_verify_proof_batch(std::span{inputs, 2}));
+}
+
+TEST(kzg, verify_proof_batch_mainnet)
+{
+    kzg_cache_clear();
+
+    auto inputs = proof_inputs(MAINNET_INPUTS);
+    for (const auto& in : inputs)
+    {
+        EXPECT_TRUE(kzg_verify_proof(in.versioned_hash.data(), in.z.data(), in.y.data(),
+            in.commitment.data(), in.proof.data()));
+    }
+
+    kzg_cache_clear();
+    EXPECT_TRUE(kzg_verify_proof_batch(inputs));
+    EXPECT_TRUE(kzg_verify_proof_batch(std::span{inputs}.first(2)));
+
+    // Mixed with the trivial proofs.
+    inputs.insert(inputs.begin() + 1, constant_proof_input(1, 9));
+    inputs.push_back(constant_proof_input(0, 10));
+    kzg_cache_clear();
+    EXPECT_TRUE(kzg_verify_proof_batch(inputs));
+}
+
+TEST(kzg, verify_proof_batch_mainnet_one_invalid)
+{
+    const auto valid_inputs = proof_inputs(MAINNET_INPUTS);
+
+    // The valid proof of another input.
+    auto inputs = valid_inputs;
+    inputs[2].proof = valid_inputs[1].proof;
+    kzg_cache_clear();
+    EXPECT_FALSE(kzg_verify_proof_batch(inputs));
+
+    // Invalid evaluation.
+    inputs = valid_inputs;
+    inputs[1].y[31] ^= std::byte{1};
+    kzg_cache_clear();
+    EXPECT_FALSE(kzg_verify_proof_batch(inputs));
+
+    // The proofs of two inputs swapped.
+    inputs = valid_inputs;
+    std::swap(inputs[0].proof, inputs[3].proof);
+    kzg_cache_clear();
+    EXPECT_FALSE(kzg_verify_proof_batch(inputs));
+
+    // The remaining valid inputs are not cached.
+    EXPECT_EQ(kzg_cache_stats().size, 0);
+}
+
+TEST(kzg, verify_proof_batch_invalid)
+{
+    kzg_cache_clear();
+
+    KzgProofInput inputs[]{constant_proof_input(0, 1), constant_proof_input(1, 2),
+        constant_proof_input(1, 3)};
+
+    // Invalid evaluation: f(3) = 2.
+    inputs[2].y[31] = std::byte{2};
+    EXPECT_FALSE(kzg_verify_proof_batch(inputs));
+
+    // Invalid versioned hash.
+    inputs[2].y[31] = std::byte{1};
+    inputs[1].versioned_hash[31] ^= std::byte{1};
+    EXPECT_FALSE(kzg_verify_proof_batch(inputs));
+
+    // Nothing has been cached.
+    EXPECT_EQ(kzg_cache_stats().size, 0);
+}
+
+TEST(kzg, verify_proof_cache)
+{
+    kzg_cache_clear();
+
+    const auto in = constant_proof_input(1, 5);
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(kzg_verify_proof(in.versioned_hash.data(), in.z.data(), in.y.data(),
+            in.commitment.data(), in.proof.data()));
+    }
+    const auto stats = kzg_cache_stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.size, 1);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 2.0 / 3.0);
+
+    // The batch verified inputs are served from the cache.
+    const auto in2 = constant_proof_input(0, 6);
+    const KzgProofInput inputs[]{in2, constant_proof_input(1, 7)};
+    EXPECT_TRUE(kzg_verify_proof_batch(inputs));
+    EXPECT_EQ(kzg_cache_stats().size, 3);
+    EXPECT_TRUE(kzg_verify_proof(in2.versioned_hash.data(), in2.z.data(), in2.y.data(),
+        in2.commitment.data(), in2.proof.data()));
+    EXPECT_EQ(kzg_cache_stats().hits, 3);
+
+    kzg_cache_clear();
+    EXPECT_EQ(kzg_cache_stats().size, 0);
+    EXPECT_EQ(kzg_cache_stats().hits, 0);
+}
+
+TEST(kzg, verify_proof_cache_different_proof)
+{
+    kzg_cache_clear();
+
+    // Cache the valid proof for f(x) = 1.
+    const auto in = constant_proof_input(1, 8);
+    EXPECT_TRUE(kzg_verify_proof(
+        in.versioned_hash.data(), in.z.data(), in.y.data(), in.commitment.data(), in.proof.data()));
+
+    // The same commitment, z and y with an invalid proof must not be accepted.
+    const auto invalid_proof = g1_generator();
+    EXPECT_FALSE(kzg_verify_proof(in.versioned_hash.data(), in.z.data(), in.y.data(),
+        in.commitment.data(), invalid_proof.data()));
+}
@@ -0,0 +1,199 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <evmone_precompiles/modexp.hpp>
+#include <gtest/gtest.h>
+#include <test/utils/utils.hpp>
+
+using evmone::test::operator""_hex;
+using evmc::bytes;
+
+namespace
+{
+std::string modexp(const bytes& base, const bytes& exp, const bytes& mod)
+{
+    bytes output(mod.size(), 0xfe);
+    evmone::crypto::modexp(output.data(), base, exp, mod);
+    return evmc::hex(output);
+}
+
+/// Generates pseudo-random bytes with the linear congruential generator.
+bytes gen(size_t size, uint32_t seed)
+{
+    bytes r(size, 0);
+    for (auto& b : r)
+    {
+        seed = seed * 1103515245 + 12345;
+        b = static_cast<uint8_t>(seed >> 16);
+    }
+    return r;
+}
+
+/// Generates the odd modulus with the top bit set.
+bytes odd_mod(size_t size, uint32_t seed)
+{
+    auto m = gen(size, seed);
+    m.front() |= 0x80;
+    m.back() |= 1;
+    return m;
+}
+
+/// Generates the odd modulus with the two top bits clear, i.e. narrower than the arithmetic
+/// selected for its size.
+bytes narrow_mod(size_t size, uint32_t seed)
+{
+    auto m = gen(size, seed);
+    m.front() &= 0x3f;
+    m.back() |= 1;
+    return m;
+}
+
+/// Generates the base with the two top bits set.
+bytes wide_base(size_t size, uint32_t seed)
+{
+    auto b = gen(size, seed);
+    b.front() |= 0xc0;
+    return b;
+}
+
+/// Generates the even modulus with the top bit set. The power-of-two factor is 2¹³ at least
+/// so the odd part is not word-aligned.
+bytes even_mod(size_t size, uint32_t seed)
+{
+    auto m = gen(size, seed);
+    m.front() |= 0x80;
+    m[size - 1] = 0;
+    m[size - 2] &= 0xe0;
+    m[size - 3] |= 1;
+    return m;
+}
+}  // namespace
+
+TEST(modexp, special_cases)
+{
+    EXPECT_EQ(modexp({}, {}, {}), "");
+    EXPECT_EQ(modexp("02"_hex, "03"_hex, "0000"_hex), "0000");
+    EXPECT_EQ(modexp("02"_hex, "03"_hex, "0001"_hex), "0000");
+    EXPECT_EQ(modexp("02"_hex, {}, "0007"_hex), "0001");
+    EXPECT_EQ(modexp("02"_hex, "0000"_hex, "0008"_hex), "0001");
+    EXPECT_EQ(modexp({}, "03"_hex, "0007"_hex), "0000");
+    EXPECT_EQ(modexp("02"_hex, "03"_hex, "0007"_hex), "0001");
+    EXPECT_EQ(modexp("02"_hex, "03"_hex, "0009"_hex), "0008");
+    EXPECT_EQ(modexp("03"_hex, "05"_hex, "0c"_hex), "03");
+    EXPECT_EQ(modexp("03"_hex, "05"_hex, "10"_hex), "03");
+}
+
+TEST(modexp, eip198_example)
+{
+    // 3^(p-1) % p = 1 for the secp256k1 field prime p.
+    EXPECT_EQ(modexp("03"_hex,
+                  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2e"_hex,
+                  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f"_hex),
+        "0000000000000000000000000000000000000000000000000000000000000001");
+}
+
+TEST(modexp, mod256_exp256)
+{
+    EXPECT_EQ(modexp(gen(32, 1), gen(32, 2), odd_mod(32, 3)),
+        "11f07a19a0abf0831419520d6c6903b27d76aebddd5b3112f68b4f9e62ca47be");
+}
+
+TEST(modexp, mod512_even)
+{
+    EXPECT_EQ(modexp(gen(64, 4), gen(32, 5), even_mod(64, 6)),
+        "24cbdee78dda02ef9d87679470a0c295e673b2a969db3bbdaec62b26cbd0876039745c553c92e3fefdf33afb773d1a3311879cc799f0526db193f5d7039c53b7");
+}
+
+TEST(modexp, mod800_exp65537)
+{
+    EXPECT_EQ(modexp(gen(100, 7), "010001"_hex, odd_mod(100, 8)),
+        "11782dd46092419a95074d82c4e47b43f3823a45cbafa8580a0fa40f1ebd55da3b3ece40ebf464dfb5a6157426a7f1fed5a777536af3bba323feadb19cd29a8bbe300fc5977eb80353213da7775aea76fcb47221f1ecb0aa93d8e9278fbaeb38afa129cc");
+}
+
+TEST(modexp, mod2048_exp65537)
+{
+    EXPECT_EQ(modexp(gen(256, 9), "010001"_hex, odd_mod(256, 10)),
+        "be363901e34bf8ee117813fdc126a8457b20d99783d1cd6ea189e858a4330cb0d36ce2f9cf57a90edecb5ce4fb83c8da2be7190fa5f2ff68aae804a78b79cc212b5c4417f5928a6e3f6f78c729305e1a00721f83e435387ad1d6ff16b169884ddd14a7e9f73aa1cae35700acd54e9cae6a056b5532d1be5a7ae605d33dcb5fd21f0e2c3ca0729dffc2ddc5f6d800fbf73922f73771158239b4f965e530934a5ce6e469af2b9e15d8f3e8a9629a14d39e283ffa5075d8df6458279145fda7faad112c076594c7686665c9cdfe52c6b0d4bce89de444354969ed102d045b7aec0eef3a04d7bea4d761b98a3dd45fb9982b960471c00bfe9e0ad62381ff48b81123");
+}
+
+TEST(modexp, mod4160_exp3)
+{
+    EXPECT_EQ(modexp(gen(520, 11), "03"_hex, odd_mod(520, 12)),
+        "9872a32c66b0b03e51476b4499f764cbf27ca75fe8383534b3c721d56f0a678113be7520d93b17e1a85287c96bad850f78a44bfa3ecaf86caf08e8babc1307a75c3ab1acf54504b8119ca9ec9a66935dcd0375603500d645e438cb29b0b741fa83ab6916a2f3e4c1e2dbbafa42b6cde6c759716c4835ced2d071e99ac3031fb6862cf926c02c8cc3ba22d964ff253125fe7f5eb027779dd87d6d1b4180a4447975e15fd65bdbe0f5cfc2c2983052f6174bc7d10ef6782a38f57668d2adeb05bfc1c428cf6083ca189aa770a20682a8f34a40f76231733ac0a72eeee622592e058edeab2df42da27018d5d34a1879fb50959fbdd7e829c9d709386b6c7ffd697378ce00bb4df34dda9d18f72e6f74b86ed8e4c1cf01781c17540b615d40fccaaa8e23611d2bf3620d21f91b83c8827e962ca8b279bccf10673a77783ad51e23a0cccc1d28486bb8060e3479e41c251a137cacd82f95088f46fb42376731670ba1386698eb9a7c3c76cf08e3d8351de6978af2635cbe756a4af5e83fcf30ede020d3f9535aa368df70ca6422943479e5472b3bcfd386a19afb24a62b4114df71ef926aa49741aae2c68071cb62738467cef9bd50a900875f3f6ed8dd2a077d4e751f847755b1db65620bdd8e1b8062ea5a5b73d48fc7087ed3c21f4c8e26d8689b2ffc86910542a736a42d12a3617f85e92b69f53c9135628635ac4849cf7e18493d0bdfb7188802b1");
+}
+
+TEST(modexp, mod4160_even)
+{
+    EXPECT_EQ(modexp(gen(520, 13), "0101"_hex, even_mod(520, 14)),
+        "a7a7a4520620d76242c6fdd9c6d85665e4c5da24c386b205ad4995b316e416677d271f19ba953363b8ea69b3f0c7a5564dc636614f13c2871d24b1a5a983d1a16316e4c97f79bed5dac76eaa3be5d27d1c39a8217155b3cce77d0e8a8e1cc659fd028aeda4ce5425898ea531e62fbe9151f2cc666d6be095fd3d3dbe047c6564a058dd449e17732bf8e1f0f552af8b3375197ce8763e1df46078a5b90921685420885dd64aa8bab4e7013d502e058e825d4dfd10190b548f47998d767a410890619f145dff6eb740111783497bb282e6f3fa5bbcc1f0c0663304165850ade6c342fb9b423487a1ca7ff4767caeb37ff6ed4e27ac7cd19fd4de8e4db5092df7ada13318181dacf136407acd7c3b7d0cb7bb5276839598e87e604953516e85350a7ba2e9801a0b77097783c4b7e62ef1e56e1d6853917bbc928cef630977bc5df7864d87e98295e796387a1fec8d036a7d17627bebe72c73a842f01a391b449094f032ed523ae3f6cee8ca226dda600803f0df4910c467670cc27488d68bbe0176c05b03ca1accecf63b1df325274f2a42d2696d4ab732f11a670b3d36b30e2c99fe70fce28d233ff5d53d04348e591509b872a3a2a766d64038ca36c564bbf0b79253fbdbe99266f1b3f131eb862c125a160080c4980d635ec48158e87b0caa139d068f57806e8f012e5af8d0488ec83ee70904987dd9582c77529f2b794fe4a8274b7fdef8e20000");
+}
+
+TEST(modexp, mod_pow2)
+{
+    auto base = gen(40, 15);
+    base.back() |= 1;
+    const auto mod = "01"_hex + bytes(25, 0);  // 2²⁰⁰
+    EXPECT_EQ(modexp(base, gen(16, 16), mod),
+        "0010ddde08f600e76f4d88190742a0301bfdf2f2a1827002e4fd");
+}
+
+TEST(modexp, base_wider_than_mod)
+{
+    EXPECT_EQ(modexp(gen(300, 17), gen(20, 18), odd_mod(20, 19)),
+        "b54f81318bafd08dbd473ccc3abaf3c128ee1a38");
+}
+
+TEST(modexp, mod4800_exp1)
+{
+    // The variable-width arithmetic with the minimal exponentiation:
+    // the cost is dominated by the setup of the Montgomery arithmetic.
+    EXPECT_EQ(modexp(gen(700, 20), "01"_hex, odd_mod(600, 21)),
+        "175a75bc124d69497825115e37f26e90822232fc6533cfffb9412f044b3bb72e5882f48837814fb2776ec6eac6af92b484d70cf7b9055d9e694f6a4deb3d9bb4ebbb9b60209304b95f692926cc3fc7ee1ed2c92eaa1a8c02e2d437ce3d33acc981f2559fcadf5bc012c79ff4a34257d85a2da0b9ef2ec6bb1a2aaeb379445314cf18bb6f59974c747937650a62951028425cfcdea1d9a2a98504b9f0899df4a6722b582bed543d3bd190a68a0a2ba6a9c3d1ecc03b1cfc16a86ea42de01c9dbcc858ef4414cd419543d6116fb71edda133eacdd472c0be3e2d48b8edee4b3ac42d610b4be1d1c2b82b480dd2507cee11852f82ab66f2de1680548ff4e032ba8bfa851f0747a2ffd636bbb7a7a8a56b8e4df3e5451d9bbc6f61b644c7c44895a50c16838e7a48c13eaf4e874872e35a976d21da75bbd96218d7713ee0b07bf9aa5f7a3a3ac4ae124707b6dc4ef11a0cd9d81d6a56d73bd9536283798b9be96e467b48ee3d8cd6eb52114f1fec112711cd0177f3a86ed5a30a98e1f4fe40d53b9d58e34f2cc961b088713b3738d47046440f12455e8d87ba883b9b4fea21b0f95c01b24ce0d3567a0997e8075abf857b95382b8b40c0142595ec5a42aa0e177d2d53eb4ea53800c1818632e4a7f926c064239f219d5718062906dcb8f5c2a163a378c334ae810741bc9675b4b248c9b523a67ed96e7ff543d7743151c1bb78cbf1000a92bf58b5fe702d3431b598f86545d5ab3595c7bfd74e1e911ab00776e48a174390ea58441f6acdc136d9af71e0b071915125dedf92f29da8850a1176c4e791433e2803502b91a72c3c7ff9166d9f1e4c1560829397ba");
+
+    auto base = gen(600, 22);
+    base.front() &= 0x7f;
+    EXPECT_EQ(modexp(base, "01"_hex, odd_mod(600, 23)), evmc::hex(base));
+}
+
+TEST(modexp, sparse_mod_full_width_base)
+{
+    // The modulus with the two most significant bits clear and the base close to 2²⁵⁶:
+    // the conversion of the base to Montgomery form must handle the unreduced input.
+    const auto base = "ffffffffffffff61de43a34354b923ddaacf5a14de9655955cc9a78ebcb82527"_hex;
+    const auto mod = "28b20257daa6aa417c3114add522f9833fb81641257bb9decae51f2b2c7b042f"_hex;
+    EXPECT_EQ(modexp(base, "01"_hex, mod),
+        "0bd3f1f0e01801d8f51d273055e74aca2c7ed48dfdaffa5c9b6aec8bb1d60c0d");
+    EXPECT_EQ(modexp(base, "010001"_hex, mod),
+        "217778033b417c0b5b92f3bf34ed807307fd8f51bfc37e250f1efd0509f28b67");
+}
+
+TEST(modexp, narrow_mod256)
+{
+    EXPECT_EQ(modexp(wide_base(32, 57), "010001"_hex, narrow_mod(32, 58)),
+        "0d393492ce869bc3980c6b50ddcf8906ae4a9e6fa80099913d6b4d96ea77dd93");
+}
+
+TEST(modexp, narrow_mod320)
+{
+    EXPECT_EQ(modexp(wide_base(40, 27), gen(32, 29), narrow_mod(40, 28)),
+        "15b218c86fb538fecdf3361d5267b50d38a793639c0a1ed2383e23e9b19a4d6a25193752d34c23b5");
+}
+
+TEST(modexp, narrow_mod512)
+{
+    EXPECT_EQ(modexp(wide_base(64, 48), "010001"_hex, narrow_mod(64, 49)),
+        "0ce8d340247f8ef1a595a265a04dabd6a0c7e405d193976ab5a477652de2046bb2d173d4788dfc525a363bdd139d2355f2f3f3cfa84d0465078079db7a5b7010");
+}
+
+TEST(modexp, narrow_mod2048)
+{
+    EXPECT_EQ(modexp(wide_base(256, 27), "010001"_hex, narrow_mod(256, 28)),
+        "15a5879add2ef62dcf9841a0aa685e364674f4a88fcbeab94da4cf018080dc50f83c5e097d18a97a17aa81fc3719944ea1f27322e8773a9969101672e6b9279e12f755e3a644cdf683569406c2a50a73c20fbcaf3d195e7888cd25ebcb5c6db594b46c8c6af1ab2dfe1f745e21225b7377970c416673f1dc2e9a82a0e96bac6e7b889750eab63b58da9b8a8082ff4c6032caa6ab480819bead120f345acd10dc596d985b1e259891390b9158f200598e787a2e3bdf2a9e0157c4c104f64527263b87bb2a72486e43dab1f0f7df4542aae738bdc22c39b658e86b2748e833e95c63d102c217507fd0d954c8cef9041ed4b727e68b6fbbec6df154ea5c275e7c52");
+}
+
+TEST(modexp, narrow_mod4160)
+{
+    EXPECT_EQ(modexp(wide_base(520, 35), "03"_hex, narrow_mod(520, 36)),
+        "1d149fc2fadf06464683f1b4a78db2ac57497822fd573233e8c752e44c83e580b9bf724e4ef16708479edff961f44d6b17b90a7f5bb1dcb5f73ae3f440550a98513911cb7da7785659159aa82850ccd469872f25f9c2c20fb9230c4ea4c3dbb054980a8cf8d57d53d6cac0eadbd4c680dcb367c0eebc95b23679cf2dac4f69ca60b8af1df4cbbec69d02e8c836169384e1d9ac7d2f1fb65810b5bfcff5bfd2df49faff742e855bc5babae440dfff1f4dc07f0df01d003a55a72dd9ba8d02822a0b6a76ffb101ac2bdae3ef175d2daf93e60e0f6337c677399dd8ee583b5a1a03cd4bc6a0c409c2879d7dd0ebf2b26fb6a921c8040aeab000e336e9454338c83aab2af44c63425b476e8b04f21fed30bd017adaee7953de87c1808f7e5d07833cd8c4848c17b604aa49ee5bbf06b3322a9f6bdf8fde926d22637525d2e124f9c40bdb60b2ec56f112600962ccbc5754141ed05be640c7903dc84f0adfebe1eb2cf9bebf8d415da7b3e519e085e806b3511d85c812c3fd3a4a9d505d696426a7c0d9c68f84d28ee198d020658885511cceb20cf57af220d04388528e3ccc41e3a0ba1441f77fc6f9eadfef3b601b37145046679036e81066f7274b88f718ebadec830348608a321325c63a4b365c7a33d893957621ea88e8e175b1d0df65808739972e18c9c32823f513e975198e5e97bcf5364653ea0622ffcb64850b8c2a26df2cec273241af9943");
+}
@@ -5,9 +5,15 @@
 #include <evmc/hex.hpp>
 #include <evmone_precompiles/ripemd160.hpp>
 #include <gtest/gtest.h>
+#include <array>
 #include <span>
+#include <string>
+#include <vector>
 
 using evmone::crypto::ripemd160;
+using evmone::crypto::ripemd160_batch;
+using evmone::crypto::ripemd160_batch_implementation;
+using evmone::crypto::set_ripemd160_batch_implementation;
 
 static std::string hex(std::span<const std::byte> x)
 {
@@ -69,3 +75,45 @@ TEST(ripemd160, input_length)
         EXPECT_EQ(hex({hash, std::size(hash)}), hash_hex) << input_length;
     }
 }
+
+TEST(ripemd160, batch)
+{
+    // Inputs of different lengths hashed together. The number of inputs is not
+    // the multiple of the batch size 8.
+    const size_t input_lengths[] = {0, 1, 54, 55, 56, 57, 63, 64, 65, 119, 120, 121, 127, 128, 129,
+        1000, 32, 32, 32, 32, 32, 32, 32, 32, 48};
+
+    std::vector<std::vector<std::byte>> inputs;
+    for (const auto input_length : input_lengths)
+    {
+        auto& input = inputs.emplace_back(input_length);
+        for (size_t i = 0; i < input_length; ++i)
+            input[i] = static_cast<std::byte>(i * 31 + input_length);
+    }
+    std::vector<std::span<const std::byte>> input_spans(inputs.begin(), inputs.end());
+
+    // Force each implementation supported by the CPU.
+    const std::string selected = ripemd160_batch_implementation();
+    for (const auto* impl : {"sequential", "avx2"})
+    {
+        if (!set_ripemd160_batch_implementation(impl))
+            continue;
+
+        for (size_t n = 0; n <= input_spans.size(); ++n)
+        {
+            std::vector<std::array<std::byte, 20>> hashes(n);
+            ripemd160_batch(reinterpret_cast<std::byte(*)[20]>(hashes.data()),
+                std::span{input_spans}.first(n));
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                std::byte expected_hash[20];
+                ripemd160(expected_hash, inputs[i].data(), inputs[i].size());
+                EXPECT_EQ(hex(hashes[i]), hex(expected_hash)) << impl << " " << n << " " << i;
+            }
+        }
+    }
+    EXPECT_TRUE(set_ripemd160_batch_implementation(selected));
+    EXPECT_FALSE(set_ripemd160_batch_implementation("unknown"));
+    EXPECT_EQ(ripemd160_batch_implementation(), selected);
+}
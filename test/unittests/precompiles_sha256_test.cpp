@@ -5,8 +5,16 @@
 #include <evmc/hex.hpp>
 #include <evmone_precompiles/sha256.hpp>
 #include <gtest/gtest.h>
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
 
 using evmone::crypto::sha256;
+using evmone::crypto::set_sha256_batch_implementation;
+using evmone::crypto::sha256_batch;
+using evmone::crypto::sha256_batch_implementation;
+using evmone::crypto::SHA256_HASH_SIZE;
 
 TEST(sha256, test_vectors)
 {
@@ -30,3 +38,45 @@ TEST(sha256, test_vectors)
         EXPECT_EQ(hash_hex, expected_hash_hex);
     }
 }
+
+TEST(sha256, batch)
+{
+    // Inputs of different lengths hashed together. The number of inputs is not
+    // the multiple of the batch size 8.
+    const size_t input_lengths[] = {0, 1, 54, 55, 56, 57, 63, 64, 65, 119, 120, 121, 127, 128, 129,
+        1000, 32, 32, 32, 32, 32, 32, 32, 32, 48};
+
+    std::vector<std::vector<std::byte>> inputs;
+    for (const auto input_length : input_lengths)
+    {
+        auto& input = inputs.emplace_back(input_length);
+        for (size_t i = 0; i < input_length; ++i)
+            input[i] = static_cast<std::byte>(i * 31 + input_length);
+    }
+    std::vector<std::span<const std::byte>> input_spans(inputs.begin(), inputs.end());
+
+    // Force each implementation supported by the CPU.
+    const std::string selected = sha256_batch_implementation();
+    for (const auto* impl : {"sequential", "avx2"})
+    {
+        if (!set_sha256_batch_implementation(impl))
+            continue;
+
+        for (size_t n = 0; n <= input_spans.size(); ++n)
+        {
+            std::vector<std::array<std::byte, SHA256_HASH_SIZE>> hashes(n);
+            sha256_batch(reinterpret_cast<std::byte(*)[SHA256_HASH_SIZE]>(hashes.data()),
+                std::span{input_spans}.first(n));
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                std::array<std::byte, SHA256_HASH_SIZE> expected_hash;
+                sha256(expected_hash.data(), inputs[i].data(), inputs[i].size());
+                EXPECT_EQ(hashes[i], expected_hash) << impl << " " << n << " " << i;
+            }
+        }
+    }
+    EXPECT_TRUE(set_sha256_batch_implementation(selected));
+    EXPECT_FALSE(set_sha256_batch_implementation("unknown"));
+    EXPECT_EQ(sha256_batch_implementation(), selected);
+}
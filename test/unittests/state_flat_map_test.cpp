@@ -0,0 +1,88 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <evmc/evmc.hpp>
+#include <gtest/gtest.h>
+#include <test/state/flat_map.hpp>
+
+using namespace evmc::literals;
+using namespace evmone::state;
+
+TEST(state_flat_map, empty)
+{
+    const FlatMap<evmc::bytes32, evmc::bytes32> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.size(), 0);
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.find(0x01_bytes32), m.end());
+    EXPECT_FALSE(m.contains({}));
+}
+
+TEST(state_flat_map, try_emplace)
+{
+    FlatMap<evmc::bytes32, evmc::bytes32> m;
+    const auto [it1, inserted1] = m.try_emplace(0x01_bytes32);
+    EXPECT_TRUE(inserted1);
+    EXPECT_EQ(it1->first, 0x01_bytes32);
+    EXPECT_EQ(it1->second, evmc::bytes32{});
+    it1->second = 0xff_bytes32;
+
+    const auto [it2, inserted2] = m.try_emplace(0x01_bytes32);
+    EXPECT_FALSE(inserted2);
+    EXPECT_EQ(it2->second, 0xff_bytes32);
+    EXPECT_EQ(m.size(), 1);
+
+    m[0x02_bytes32] = 0xfe_bytes32;
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.find(0x02_bytes32)->second, 0xfe_bytes32);
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_FALSE(m.contains(0x01_bytes32));
+}
+
+TEST(state_flat_map, many_keys)
+{
+    // Checks both small integer keys (collide in most significant bytes)
+    // and addresses (non-multiple of 8 bytes).
+    static constexpr uint64_t N = 10000;
+    FlatMap<evmc::bytes32, uint64_t> storage;
+    FlatMap<evmc::address, uint64_t> accounts;
+    for (uint64_t i = 0; i < N; ++i)
+    {
+        storage[evmc::bytes32{i}] = i;
+        accounts[evmc::address{i << 32}] = i;
+    }
+    EXPECT_EQ(storage.size(), N);
+    EXPECT_EQ(accounts.size(), N);
+
+    for (uint64_t i = 0; i < N; ++i)
+    {
+        const auto sit = storage.find(evmc::bytes32{i});
+        ASSERT_NE(sit, storage.end());
+        EXPECT_EQ(sit->second, i);
+        const auto ait = accounts.find(evmc::address{i << 32});
+        ASSERT_NE(ait, accounts.end());
+        EXPECT_EQ(ait->second, i);
+    }
+    EXPECT_FALSE(storage.contains(evmc::bytes32{N}));
+    EXPECT_FALSE(accounts.contains(evmc::address{N << 32}));
+}
+
+TEST(state_flat_map, iteration_in_insertion_order)
+{
+    FlatMap<evmc::bytes32, int> m;
+    m.reserve(100);
+    for (int i = 99; i >= 0; --i)
+        m[evmc::bytes32{static_cast<uint64_t>(i)}] = i;
+
+    int expected = 99;
+    for (const auto& [k, v] : m)
+    {
+        EXPECT_EQ(k, evmc::bytes32{static_cast<uint64_t>(expected)});
+        EXPECT_EQ(v, expected);
+        --expected;
+    }
+    EXPECT_EQ(expected, -1);
+}
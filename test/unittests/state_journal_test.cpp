@@ -0,0 +1,75 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/state/journal.hpp>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace evmone::state;
+
+namespace
+{
+struct Small
+{
+    uint8_t v;
+};
+
+struct Big
+{
+    uint64_t a;
+    uint64_t b;
+    uint8_t c[13];
+};
+
+using TestJournal = Journal<Small, Big>;
+using Undone = std::vector<std::variant<Small, Big>>;
+
+void collect(TestJournal& journal, size_t checkpoint, Undone& undone)
+{
+    journal.rollback(checkpoint, [&undone](const auto& e) { undone.emplace_back(e); });
+}
+}  // namespace
+
+TEST(state_journal, packed_size)
+{
+    TestJournal journal;
+    EXPECT_EQ(journal.size(), 0);
+    journal.push(Small{1});
+    EXPECT_EQ(journal.size(), sizeof(Small) + 1);
+    journal.push(Big{});
+    EXPECT_EQ(journal.size(), sizeof(Small) + 1 + sizeof(Big) + 1);
+}
+
+TEST(state_journal, rollback_order)
+{
+    TestJournal journal;
+    journal.push(Small{1});
+    const auto checkpoint = journal.size();
+    journal.push(Big{2, 3, {4}});
+    journal.push(Small{5});
+    journal.push(Small{6});
+    journal.push(Big{7, 8, {9}});
+
+    Undone undone;
+    collect(journal, checkpoint, undone);
+    EXPECT_EQ(journal.size(), checkpoint);
+    ASSERT_EQ(undone.size(), 4);
+    EXPECT_EQ(std::get<Big>(undone[0]).a, 7);
+    EXPECT_EQ(std::get<Big>(undone[0]).b, 8);
+    EXPECT_EQ(std::get<Big>(undone[0]).c[0], 9);
+    EXPECT_EQ(std::get<Small>(undone[1]).v, 6);
+    EXPECT_EQ(std::get<Small>(undone[2]).v, 5);
+    EXPECT_EQ(std::get<Big>(undone[3]).a, 2);
+
+    undone.clear();
+    collect(journal, journal.size(), undone);
+    EXPECT_TRUE(undone.empty());
+
+    collect(journal, 0, undone);
+    ASSERT_EQ(undone.size(), 1);
+    EXPECT_EQ(std::get<Small>(undone[0]).v, 1);
+    EXPECT_EQ(journal.size(), 0);
+}
@@ -4,9 +4,12 @@
 
 #include <gtest/gtest.h>
 #include <test/state/precompiles.hpp>
+#include <test/state/precompiles_internal.hpp>
+#include <test/utils/utils.hpp>
 
 using namespace evmc;
 using namespace evmone::state;
+using namespace evmone::test;
 
 TEST(state_precompiles, is_precompile)
 {
@@ -52,3 +55,130 @@ TEST(state_precompiles, is_precompile)
         EXPECT_FALSE(is_precompile(rev, 0x17_address));
     }
 }
+
+TEST(state_precompiles, call_precompile_output_buffer)
+{
+    const bytes input{1, 2, 3, 4, 5};
+    evmc_message msg{.gas = 1000, .input_data = input.data(), .input_size = input.size()};
+    msg.code_address = 0x02_address;  // sha256
+
+    bytes buffer;
+    const auto r1 = call_precompile(EVMC_CANCUN, msg, buffer);
+    EXPECT_EQ(r1.status_code, EVMC_SUCCESS);
+    EXPECT_EQ(r1.gas_left, 1000 - 72);
+    EXPECT_EQ(r1.output_data, buffer.data());
+    EXPECT_EQ(bytes_view(r1.output_data, r1.output_size),
+        "74f81fe167d99b4cb41d6d0ccda82278caee9f3e2f25d5e5a3936ff3dcec60d0"_hex);
+
+    // The output of the next call reuses the buffer.
+    msg.input_size = 2;
+    const auto* const buffer_data = buffer.data();
+    const auto r2 = call_precompile(EVMC_CANCUN, msg, buffer);
+    EXPECT_EQ(r2.status_code, EVMC_SUCCESS);
+    EXPECT_EQ(r2.output_data, buffer_data);
+    EXPECT_EQ(bytes_view(r2.output_data, r2.output_size),
+        "a12871fee210fb8619291eaea194581cbd2531e4b23759d225f6806923f63222"_hex);
+
+    // Same output as from the call allocating the output.
+    const auto r3 = call_precompile(EVMC_CANCUN, msg);
+    EXPECT_EQ(r3.status_code, r2.status_code);
+    EXPECT_EQ(r3.gas_left, r2.gas_left);
+    EXPECT_EQ(bytes_view(r3.output_data, r3.output_size), bytes_view(r2.output_data, 32));
+
+    msg.gas = 71;
+    const auto r4 = call_precompile(EVMC_CANCUN, msg, buffer);
+    EXPECT_EQ(r4.status_code, EVMC_OUT_OF_GAS);
+    EXPECT_EQ(r4.gas_left, 0);
+}
+
+TEST(state_precompiles, call_precompile_identity_references_input)
+{
+    const bytes input{1, 2, 3, 4, 5};
+    evmc_message msg{.gas = 1000, .input_data = input.data(), .input_size = input.size()};
+    msg.code_address = 0x04_address;  // identity
+
+    // The output of the identity references the input instead of the buffer.
+    bytes buffer;
+    const auto r1 = call_precompile(EVMC_CANCUN, msg, buffer);
+    EXPECT_EQ(r1.status_code, EVMC_SUCCESS);
+    EXPECT_EQ(r1.gas_left, 1000 - 18);
+    EXPECT_EQ(r1.output_data, input.data());
+    EXPECT_EQ(r1.output_size, input.size());
+    EXPECT_TRUE(buffer.empty());
+
+    // The call allocating the output copies the input.
+    const auto r2 = call_precompile(EVMC_CANCUN, msg);
+    EXPECT_EQ(r2.status_code, EVMC_SUCCESS);
+    EXPECT_EQ(r2.gas_left, r1.gas_left);
+    EXPECT_NE(r2.output_data, input.data());
+    EXPECT_EQ(bytes_view(r2.output_data, r2.output_size), input);
+
+    msg.gas = 17;
+    const auto r3 = call_precompile(EVMC_CANCUN, msg, buffer);
+    EXPECT_EQ(r3.status_code, EVMC_OUT_OF_GAS);
+    EXPECT_EQ(r3.gas_left, 0);
+}
+
+TEST(state_precompiles, identity_large_input)
+{
+    // Use the unaligned output.
+    bytes input(1024 * 1024 + 77, 0);
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<uint8_t>(i * 7);
+    bytes output(input.size() + 1, 0);
+    const auto r = identity_execute(input.data(), input.size(), &output[1], input.size());
+    EXPECT_EQ(r.status_code, EVMC_SUCCESS);
+    EXPECT_EQ(r.output_size, input.size());
+    EXPECT_EQ(output[0], 0);
+    EXPECT_EQ(bytes_view(&output[1], input.size()), input);
+}
+
+TEST(state_precompiles, call_precompile_memo)
+{
+    // expmod: 3^2 % 5 with 1-byte lengths.
+    const auto input =
+        "000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000001030205"_hex;
+    evmc_message msg{.gas = 1000, .input_data = input.data(), .input_size = input.size()};
+    msg.code_address = 0x05_address;  // expmod
+
+    // The memo is disabled by default.
+    precompile_memo_clear();
+    const auto r0 = call_precompile(EVMC_CANCUN, msg);
+    EXPECT_EQ(r0.status_code, EVMC_SUCCESS);
+    EXPECT_EQ(precompile_memo_stats().misses, 0);
+
+    set_precompile_memo_limit(1024 * 1024);
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto r = call_precompile(EVMC_CANCUN, msg);
+        EXPECT_EQ(r.status_code, EVMC_SUCCESS);
+        EXPECT_EQ(r.gas_left, 1000 - 200);
+        EXPECT_EQ(bytes_view(r.output_data, r.output_size), "04"_hex);
+    }
+    auto stats = precompile_memo_stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.size, 1);
+    EXPECT_GT(stats.memory, 0);
+
+    // The revision is part of the key.
+    const auto r_berlin = call_precompile(EVMC_BERLIN, msg);
+    EXPECT_EQ(bytes_view(r_berlin.output_data, r_berlin.output_size), "04"_hex);
+    EXPECT_EQ(precompile_memo_stats().size, 2);
+
+    // The cheap precompiles are not memoized.
+    msg.code_address = 0x04_address;  // identity
+    const auto r_identity = call_precompile(EVMC_CANCUN, msg);
+    EXPECT_EQ(bytes_view(r_identity.output_data, r_identity.output_size), input);
+    EXPECT_EQ(precompile_memo_stats().size, 2);
+
+    // Lowering the limit evicts the results.
+    set_precompile_memo_limit(stats.memory);
+    stats = precompile_memo_stats();
+    EXPECT_EQ(stats.size, 1);
+    EXPECT_EQ(stats.evictions, 1);
+
+    set_precompile_memo_limit(0);
+    precompile_memo_clear();
+    EXPECT_EQ(precompile_memo_stats().size, 0);
+}
@@ -50,3 +50,30 @@ TEST_F(state_transition, delegatecall_static_legacy)
     expect.post[CALLEE1].storage[0x01_bytes32] = 0xdd_bytes32;
     expect.post[CALLEE2].storage[0x01_bytes32] = 0xdd_bytes32;
 }
+
+TEST_F(state_transition, storage_access_across_frames)
+{
+    // Checks that the storage accesses are applied to the recipient of the executing frame
+    // and the parent frame continues with its own storage after nested calls return.
+    rev = EVMC_CANCUN;
+    static constexpr auto CALLEE = 0xca11ee_address;
+    static constexpr auto LIBRARY = 0x11b0_address;
+    pre[CALLEE] = {
+        .storage = {{0x01_bytes32, 0xdd_bytes32}},
+        .code = sstore(1, 0x22) + sstore(2, sload(1)) + revert(0, 0),
+    };
+    pre[LIBRARY] = {.code = sstore(3, sload(1))};
+    tx.to = To;
+    pre[To] = {
+        .code = sstore(1, 0x11) + sstore(4, call(CALLEE).gas(100'000)) +
+                sstore(5, delegatecall(LIBRARY).gas(100'000)) + sstore(6, sload(1)),
+    };
+
+    expect.post[To].storage[0x01_bytes32] = 0x11_bytes32;
+    expect.post[To].storage[0x03_bytes32] = 0x11_bytes32;
+    expect.post[To].storage[0x04_bytes32] = 0x00_bytes32;
+    expect.post[To].storage[0x05_bytes32] = 0x01_bytes32;
+    expect.post[To].storage[0x06_bytes32] = 0x11_bytes32;
+    expect.post[CALLEE].storage[0x01_bytes32] = 0xdd_bytes32;
+    expect.post[LIBRARY].exists = true;
+}
@@ -192,3 +192,120 @@ TEST(state_tx, validate_tx_data_cost)
     EXPECT_EQ(get_props(EVMC_CANCUN).min_gas_cost, 0);
     EXPECT_EQ(get_props(EVMC_PRAGUE).min_gas_cost, 21000 + (4 * 3 + 2) * 10);
 }
+
+TEST(state_tx, recover_signers)
+{
+    using namespace intx;
+
+    const Authorization auth{
+        .chain_id = 1,
+        .addr = 0xbb_address,
+        .nonce = 5,
+        .r = 0xf30e4bd8094e53a679ddb8f55b5216b03c44623fc4279ef0791f9aa1f6930d49_u256,
+        .s = 0x6fb0d561d5bfb37a7d9fa789d28b2ed1fbbebe03b54e7036dab781fe4b14d34a_u256,
+        .v = 1,
+    };
+    auto invalid_auth = auth;
+    invalid_auth.v = 3;
+    // The signer already provided is kept even if the signature is invalid.
+    auto provided_auth = invalid_auth;
+    provided_auth.signer = 0x01_address;
+
+    std::vector<Transaction> txs{
+        // Example from
+        // https://etherscan.io/tx/0x033e9f8db737193d4666911a164e218d58d80edc64f4ed393d0c48c1ce2673e7
+        {
+            .type = Transaction::Type::legacy,
+            .data = "a0712d680000000000000000000000000000000000000000000000000000000000000003"_hex,
+            .gas_limit = 421566,
+            .max_gas_price = 14829580649,
+            .to = 0x963eda46936b489f4a0d153c20e47653d8bbf222_address,
+            .value = 480000000000000000,
+            .chain_id = 1,
+            .nonce = 0,
+            .r = 0x3bcaa4f1603d2b3ebe6126f57e0ddefc6c6c58d8bbef7f3b29e14a915bf1828d_u256,
+            .s = 0x00f37b7a0b6007ef4335a35198485e443051d45b42fea8bacc054721ecccdb5f_u256,
+            .v = 27,
+        },
+        // Example from
+        // https://etherscan.io/tx/0xee8d0f04073a6792b1bd6b1cb0b88cb57984905979d2668f84b9c3dcb8894da6
+        {
+            .type = Transaction::Type::eip1559,
+            .gas_limit = 30000,
+            .max_gas_price = 14237787676,
+            .max_priority_gas_price = 0,
+            .to = 0x535b918f3724001fd6fb52fcc6cbc220592990a3_address,
+            .value = 73360267083380739,
+            .chain_id = 1,
+            .nonce = 132949,
+            .r = 0x2fe690e16de3534bee626150596573d57cb56d0c2e48a02f64c0a03c1636ce2a_u256,
+            .s = 0x4814f3dc7dac2ee153a2456aa3968717af7400972167dfb00b1cce1c23b6dd9f_u256,
+            .v = 1,
+        },
+        // EIP-155 legacy transaction.
+        {
+            .type = Transaction::Type::legacy,
+            .gas_limit = 21000,
+            .max_gas_price = 10,
+            .to = 0xaa_address,
+            .value = 1,
+            .chain_id = 1,
+            .nonce = 7,
+            .r = 0xd47644539acec3da5e3ecf5fe8863c628a9c97e8b71e9ea9167a6f4f83c03c32_u256,
+            .s = 0x12057763bdbab65fbff3c759dc1330e7151d2886abcef6858946401830553d95_u256,
+            .v = 37,
+        },
+        // Set code transaction with a valid, an invalid (v > 1) and a provided authorization.
+        {
+            .type = Transaction::Type::set_code,
+            .gas_limit = 100000,
+            .max_gas_price = 10,
+            .max_priority_gas_price = 1,
+            .to = 0xaa_address,
+            .chain_id = 1,
+            .nonce = 8,
+            .r = 0x12faae608bd6562562b8f85564664cd1fdcd667f6b24b2b221ef86b9231f4d74_u256,
+            .s = 0x4cc6042cd58a53f085b7afccf7e5cc260e77a1ea4ee43c29a51cc764f7fad275_u256,
+            .v = 0,
+            .authorization_list = {auth, invalid_auth, provided_auth},
+        },
+        // Invalid signature: the sender is not modified.
+        {
+            .type = Transaction::Type::eip1559,
+            .sender = 0x02_address,
+            .r = 0,
+            .s = 1,
+        },
+        // EIP-155 legacy transaction with the chain ID 5 encoded in v.
+        // The chain_id is left at the default of the loaders.
+        {
+            .type = Transaction::Type::legacy,
+            .gas_limit = 21000,
+            .max_gas_price = 10,
+            .to = 0xaa_address,
+            .value = 1,
+            .chain_id = 1,
+            .nonce = 7,
+            .r = 0xf973a0b87062c389d125d8199e803b832b6ac6bf7867a4f6cd87506060fc4c58_u256,
+            .s = 0x6fc2ac8e2ba523d257a26361bb609f39eeb273d4fe121f990a3ef3097aaaf250_u256,
+            .v = 5 * 2 + 35 + 1,
+        },
+    };
+
+    // The provided sender is kept even if the signature is valid.
+    txs.push_back(txs[0]);
+    txs.back().sender = 0x03_address;
+
+    recover_signers(txs, {true, true, true, true, true, true, false});
+    EXPECT_EQ(txs[0].sender, 0xc9d955665d6f90ef483a1ac0bd2443c17a550db7_address);
+    EXPECT_EQ(txs[1].sender, 0x95222290dd7278aa3ddd389cc1e1d165cc4bafe5_address);
+    EXPECT_EQ(txs[2].sender, 0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b_address);
+    EXPECT_EQ(txs[3].sender, 0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b_address);
+    EXPECT_EQ(
+        txs[3].authorization_list[0].signer, 0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b_address);
+    EXPECT_EQ(txs[3].authorization_list[1].signer, std::nullopt);
+    EXPECT_EQ(txs[3].authorization_list[2].signer, 0x01_address);
+    EXPECT_EQ(txs[4].sender, 0x02_address);
+    EXPECT_EQ(txs[5].sender, 0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b_address);
+    EXPECT_EQ(txs[6].sender, 0x03_address);
+}